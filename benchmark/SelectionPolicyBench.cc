@@ -0,0 +1,118 @@
+/*
+ * SelectionPolicyBench.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * Author: agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <opencog/util/mt19937ar.h>
+#include <opencog/atoms/truthvalue/SimpleTruthValue.h>
+#include <opencog/ure/SelectionPolicy.h>
+#include <opencog/ure/ThompsonSampling.h>
+
+using namespace opencog;
+
+/**
+ * Compare the cost and the quality of the selection policies.
+ *
+ * Each action has a hidden probability of success, drawn uniformly
+ * in [0, 1], and a TV estimated from a random number of trials of
+ * that action, between 1 and max_trials. The quality of a policy is
+ * measured by its average regret, the difference between the
+ * probability of success of the best action and the one of the
+ * selected action, the lower the better.
+ *
+ * Usage: selection-policy-bench [ACTIONS [DRAWS [SEED [MAX_TRIALS]]]]
+ */
+int main(int argc, char** argv)
+{
+	size_t n_actions = argc > 1 ? std::stoul(argv[1]) : 200,
+		n_draws = argc > 2 ? std::stoul(argv[2]) : 100;
+	unsigned long seed = argc > 3 ? std::stoul(argv[3]) : 0;
+	unsigned max_trials = argc > 4 ? std::stoul(argv[4]) : 20;
+	if (n_actions == 0 or max_trials == 0) {
+		std::cerr << "Usage: " << argv[0]
+		          << " [ACTIONS [DRAWS [SEED [MAX_TRIALS]]]]" << std::endl;
+		return 1;
+	}
+	randGen().seed(seed);
+
+	// Generate the actions
+	std::vector<double> probs;
+	TruthValueSeq tvs;
+	for (size_t i = 0; i < n_actions; i++) {
+		double p = randGen().randdouble();
+		unsigned trials = 1 + randGen().randint(max_trials),
+			successes = 0;
+		for (unsigned t = 0; t < trials; t++)
+			successes += randGen().randdouble() < p;
+		double count = trials,
+			confidence = count / (count + SimpleTruthValue::DEFAULT_K);
+		probs.push_back(p);
+		tvs.push_back(SimpleTruthValue::createTV(successes / count,
+		                                         confidence));
+	}
+	double best_prob = *std::max_element(probs.begin(), probs.end());
+
+	// Run n_draws selections, report their time and average regret
+	auto run = [&](const std::string& name,
+	               const std::function<size_t()>& select) {
+		double regret = 0.0;
+		auto start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < n_draws; i++)
+			regret += best_prob - probs[select()];
+		std::chrono::duration<double> elapsed =
+			std::chrono::steady_clock::now() - start;
+		std::cout << name << ": " << elapsed.count() << "s, "
+		          << "average regret " << regret / n_draws << std::endl;
+	};
+
+	std::cout << n_draws << " draws over " << n_actions << " actions, "
+	          << "seed " << seed << ", at most " << max_trials
+	          << " trials per action" << std::endl;
+
+	// Thompson sampling with its distribution numerically calculated,
+	// as done when the distribution is required.
+	ThompsonSampling ts(tvs);
+	run("Thompson (distribution)", [&]() {
+			std::vector<double> weights = ts.distribution();
+			std::discrete_distribution<size_t> dist(weights.begin(),
+			                                        weights.end());
+			return dist(randGen());
+		});
+
+	for (SelectionPolicy policy : {SelectionPolicy::Thompson,
+	                               SelectionPolicy::SingleDrawThompson,
+	                               SelectionPolicy::BayesUCB,
+	                               SelectionPolicy::Tournament}) {
+		PolicySelection psel(tvs, policy);
+		run(oc_to_string(policy), [&]() { return psel(); });
+	}
+
+	return 0;
+}
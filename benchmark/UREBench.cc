@@ -0,0 +1,402 @@
+/*
+ * UREBench.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * Author: agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <opencog/util/exceptions.h>
+#include <opencog/util/Logger.h>
+#include <opencog/util/random.h>
+#include <opencog/guile/SchemeEval.h>
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/ure/forwardchainer/ForwardChainer.h>
+#include <opencog/ure/backwardchainer/BackwardChainer.h>
+#include <opencog/ure/URELogger.h>
+
+using namespace opencog;
+
+#define al _as->add_link
+#define an _as->add_node
+
+/**
+ * End-to-end benchmarks of the forward and backward chainers over
+ * synthetic knowledge bases of configurable size and seed, see
+ * ure-bench.scm. Each run takes place in its own process, so that
+ * its memory usage is not mixed with the one of the previous runs,
+ * and is reported as a single line
+ *
+ * URE-BENCH {"chainer": ..., "workload": ..., "size": ..., ...}
+ *
+ * holding a JSON object with the number of iterations, the elapsed
+ * time, the number of iterations per second, the number of results,
+ * the peak resident set size of the run, the growth of the resident
+ * set size during chaining, the time spent in each phase of the
+ * chainer (see PhaseTimers) and its counts of unifications, rule
+ * applications, etc (see ChainerStats).
+ */
+class UREBench
+{
+public:
+	UREBench();
+
+	// Generate the knowledge base of the given workload, size and
+	// seed, run the chainer over it and print its measures.
+	void fc_deduction_chain(size_t size, unsigned long seed);
+	void fc_deduction_graph(size_t size, unsigned long seed);
+	void fc_modus_ponens(size_t size, unsigned long seed);
+	void fc_conjunction(size_t size, unsigned long seed);
+	void bc_deduction_chain(size_t size, unsigned long seed);
+	void bc_deduction_graph(size_t size, unsigned long seed);
+	void bc_modus_ponens(size_t size, unsigned long seed);
+
+private:
+	AtomSpacePtr _as;
+	SchemeEval _eval;
+
+	// Maximum number of iterations of each run
+	static const int max_iterations = 50;
+
+	// Run the given chainer and print its measures. run is expected
+	// to perform chaining, fill the timings of its phases and its
+	// statistics as JSON, and return the number of iterations and
+	// results.
+	void bench(const std::string& chainer, const std::string& workload,
+	           size_t size, unsigned long seed,
+	           const std::function<std::pair<int, size_t>(PhaseTimers::Timings&,
+	                                                      std::string&)>& run);
+
+	// Run the forward chainer with the given rule base and sources
+	void bench_fc(const std::string& workload, size_t size, unsigned long seed,
+	              const std::string& rbs, const Handle& sources);
+
+	// Run the backward chainer with the given rule base and target
+	void bench_bc(const std::string& workload, size_t size, unsigned long seed,
+	              const std::string& rbs, const Handle& target,
+	              const Handle& vardecl=Handle::UNDEFINED);
+};
+
+// Current resident set size of the process in kilobytes, read from
+// /proc/self/statm.
+static long current_rss()
+{
+	long size = 0, resident = 0;
+	std::ifstream statm("/proc/self/statm");
+	statm >> size >> resident;
+	return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+// Peak resident set size of the process in kilobytes. As resource
+// usages are reset by fork, it is the peak of the run.
+static long peak_rss()
+{
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss;
+}
+
+UREBench::UREBench() : _as(createAtomSpace()), _eval(_as)
+{
+	logger().set_level(Logger::WARN);
+	logger().set_print_to_stdout_flag(true);
+	ure_logger().set_level(Logger::WARN);
+	ure_logger().set_print_to_stdout_flag(true);
+
+	std::string source_dir = PROJECT_SOURCE_DIR,
+		binary_dir = PROJECT_BINARY_DIR;
+	std::vector<std::string> load_paths = {source_dir,
+	                                       source_dir + "/benchmark",
+	                                       source_dir + "/opencog/scm/opencog/ure",
+	                                       binary_dir + "/opencog/scm"};
+	for (const std::string& p : load_paths)
+		_eval.eval("(add-to-load-path \"" + p + "\")");
+	_eval.eval("(use-modules (opencog))");
+	_eval.eval("(use-modules (opencog ure))");
+	_eval.eval("(load-from-path \"ure-bench.scm\")");
+	if (_eval.eval_error())
+		throw RuntimeException(TRACE_INFO, "Cannot load ure-bench.scm");
+}
+
+void UREBench::bench(const std::string& chainer, const std::string& workload,
+                     size_t size, unsigned long seed,
+                     const std::function<std::pair<int, size_t>(PhaseTimers::Timings&,
+                                                                std::string&)>& run)
+{
+	randGen().seed(seed);
+	PhaseTimers::Timings timings;
+	std::string stats;
+	long start_rss = current_rss();
+	auto start = std::chrono::steady_clock::now();
+	std::pair<int, size_t> iters_results = run(timings, stats);
+	std::chrono::duration<double> elapsed =
+		std::chrono::steady_clock::now() - start;
+
+	int iterations = iters_results.first;
+	double seconds = elapsed.count();
+	std::stringstream ss;
+	ss << "{\"chainer\": \"" << chainer << "\""
+	   << ", \"workload\": \"" << workload << "\""
+	   << ", \"size\": " << size
+	   << ", \"seed\": " << seed
+	   << ", \"iterations\": " << iterations
+	   << ", \"seconds\": " << seconds
+	   << ", \"iterations_per_second\": "
+	   << (0 < seconds ? iterations / seconds : 0)
+	   << ", \"results\": " << iters_results.second
+	   << ", \"peak_rss_kb\": " << peak_rss()
+	   << ", \"rss_growth_kb\": " << current_rss() - start_rss
+	   << ", \"phases\": {";
+	for (auto it = timings.begin(); it != timings.end(); ++it)
+		ss << (it == timings.begin() ? "" : ", ")
+		   << "\"" << it->first << "\": {\"seconds\": " << it->second.seconds
+		   << ", \"count\": " << it->second.count << "}";
+	ss << "}, \"stats\": " << stats << "}";
+	std::cout << "URE-BENCH " << ss.str() << std::endl;
+}
+
+void UREBench::bench_fc(const std::string& workload, size_t size,
+                        unsigned long seed, const std::string& rbs,
+                        const Handle& sources)
+{
+	if (not sources)
+		throw RuntimeException(TRACE_INFO, "Cannot generate the sources of %s",
+		                       workload.c_str());
+	Handle rbs_h = an(CONCEPT_NODE, rbs);
+	bench("fc", workload, size, seed, [&](PhaseTimers::Timings& timings,
+	                                      std::string& stats) {
+			ForwardChainer fc(*_as.get(), rbs_h, sources);
+			fc.get_config().set_maximum_iterations(max_iterations);
+			fc.get_config().set_phase_timing(true);
+			fc.do_chain();
+			timings = fc.get_phase_timers().get_timings();
+			stats = fc.get_stats().to_json();
+			return std::make_pair(fc.get_iteration(),
+			                      fc.get_results_set().size());
+		});
+}
+
+void UREBench::bench_bc(const std::string& workload, size_t size,
+                        unsigned long seed, const std::string& rbs,
+                        const Handle& target, const Handle& vardecl)
+{
+	Handle rbs_h = an(CONCEPT_NODE, rbs);
+	bench("bc", workload, size, seed, [&](PhaseTimers::Timings& timings,
+	                                      std::string& stats) {
+			BackwardChainer bc(*_as.get(), rbs_h, target, vardecl);
+			bc.get_config().set_maximum_iterations(max_iterations);
+			bc.get_config().set_phase_timing(true);
+			bc.do_chain();
+			timings = bc.get_phase_timers().get_timings();
+			stats = bc.get_stats().to_json();
+			return std::make_pair(bc.get_iteration(),
+			                      bc.get_results_set().size());
+		});
+}
+
+/**
+ * Deduction over an inheritance chain
+ */
+void UREBench::fc_deduction_chain(size_t n, unsigned long seed)
+{
+	Handle sources = _eval.eval_h("(gen-inheritance-chain "
+	                              + std::to_string(n) + ")");
+	bench_fc("deduction-chain", n, seed, "bench-fc-deduction-rbs", sources);
+}
+
+/**
+ * Deduction over a random inheritance graph
+ */
+void UREBench::fc_deduction_graph(size_t n, unsigned long seed)
+{
+	Handle sources = _eval.eval_h("(gen-inheritance-graph "
+	                              + std::to_string(n) + " "
+	                              + std::to_string(2 * n) + " "
+	                              + std::to_string(seed) + ")");
+	bench_fc("deduction-graph", n, seed, "bench-fc-deduction-rbs", sources);
+}
+
+/**
+ * Modus ponens over a random implication network
+ */
+void UREBench::fc_modus_ponens(size_t n, unsigned long seed)
+{
+	Handle sources = _eval.eval_h("(gen-implication-network "
+	                              + std::to_string(n) + " "
+	                              + std::to_string(n) + " "
+	                              + std::to_string(seed) + ")");
+	bench_fc("modus-ponens", n, seed, "bench-modus-ponens-rbs", sources);
+}
+
+/**
+ * Conjunction introduction over n predicates
+ */
+void UREBench::fc_conjunction(size_t n, unsigned long seed)
+{
+	Handle sources = _eval.eval_h("(gen-evaluations "
+	                              + std::to_string(n) + " "
+	                              + std::to_string(seed) + ")");
+	bench_fc("conjunction", n, seed, "bench-conjunction-rbs", sources);
+}
+
+/**
+ * Backward deduction of all ancestors of the end of an inheritance
+ * chain
+ */
+void UREBench::bc_deduction_chain(size_t n, unsigned long seed)
+{
+	_eval.eval("(gen-inheritance-chain " + std::to_string(n) + ")");
+	Handle X = an(VARIABLE_NODE, "$X"),
+		CT = an(TYPE_NODE, "ConceptNode"),
+		vardecl = al(TYPED_VARIABLE_LINK, X, CT),
+		target = al(INHERITANCE_LINK, X,
+		            an(CONCEPT_NODE, "C-" + std::to_string(n)));
+	bench_bc("deduction-chain", n, seed, "bench-bc-deduction-rbs",
+	         target, vardecl);
+}
+
+/**
+ * Backward deduction of a relationship within a random inheritance
+ * graph
+ */
+void UREBench::bc_deduction_graph(size_t n, unsigned long seed)
+{
+	_eval.eval("(gen-inheritance-graph " + std::to_string(n) + " "
+	           + std::to_string(2 * n) + " " + std::to_string(seed) + ")");
+	Handle target = al(INHERITANCE_LINK,
+	                   an(CONCEPT_NODE, "C-0"),
+	                   an(CONCEPT_NODE, "C-" + std::to_string(n - 1)));
+	bench_bc("deduction-graph", n, seed, "bench-bc-deduction-rbs", target);
+}
+
+/**
+ * Backward modus ponens of the end of a random implication network
+ */
+void UREBench::bc_modus_ponens(size_t n, unsigned long seed)
+{
+	_eval.eval("(gen-implication-network " + std::to_string(n) + " "
+	           + std::to_string(n) + " " + std::to_string(seed) + ")");
+	Handle target = an(PREDICATE_NODE, "P-" + std::to_string(n - 1));
+	bench_bc("modus-ponens", n, seed, "bench-modus-ponens-rbs", target);
+}
+
+// Parse a comma separated list of non-negative integers
+static std::vector<size_t> parse_list(const std::string& str)
+{
+	std::vector<size_t> values;
+	std::stringstream ss(str);
+	std::string value;
+	while (std::getline(ss, value, ','))
+		values.push_back(std::stoul(value));
+	return values;
+}
+
+/**
+ * Usage: ure-bench [WORKLOAD [SEEDS [SIZES]]]
+ *
+ * where WORKLOAD is one of fc-deduction-chain, fc-deduction-graph,
+ * fc-modus-ponens, fc-conjunction, bc-deduction-chain,
+ * bc-deduction-graph, bc-modus-ponens or all (the default), and
+ * SEEDS and SIZES are comma separated lists, 0 and the default
+ * sizes of the workload if omitted. The workload is run for each
+ * size and each seed, each in its own process.
+ */
+int main(int argc, char** argv)
+{
+	typedef void (UREBench::*Run)(size_t, unsigned long);
+	struct Workload
+	{
+		std::string name;
+		Run run;
+		std::vector<size_t> sizes;
+	};
+	std::vector<Workload> workloads{
+		{"fc-deduction-chain", &UREBench::fc_deduction_chain, {10, 30}},
+		{"fc-deduction-graph", &UREBench::fc_deduction_graph, {10, 30}},
+		{"fc-modus-ponens", &UREBench::fc_modus_ponens, {10, 30}},
+		{"fc-conjunction", &UREBench::fc_conjunction, {5, 10}},
+		{"bc-deduction-chain", &UREBench::bc_deduction_chain, {5, 10}},
+		{"bc-deduction-graph", &UREBench::bc_deduction_graph, {10, 30}},
+		{"bc-modus-ponens", &UREBench::bc_modus_ponens, {10, 30}}};
+
+	std::string name = argc > 1 ? argv[1] : "all";
+	std::vector<size_t> seeds = parse_list(argc > 2 ? argv[2] : "0"),
+		sizes = argc > 3 ? parse_list(argv[3]) : std::vector<size_t>();
+
+	std::vector<const Workload*> selected;
+	for (const Workload& w : workloads)
+		if (name == "all" or name == w.name)
+			selected.push_back(&w);
+	if (selected.empty() or seeds.empty() or
+	    std::find(sizes.begin(), sizes.end(), 0) != sizes.end()) {
+		std::cerr << "Usage: " << argv[0]
+		          << " [WORKLOAD [SEEDS [SIZES]]]" << std::endl;
+		return 1;
+	}
+
+	int status = 0;
+	for (const Workload* w : selected) {
+		for (size_t size : sizes.empty() ? w->sizes : sizes) {
+			for (size_t seed : seeds) {
+				// Run in a child process so that its peak RSS is its
+				// own, the atomspace and guile are only created there.
+				std::cout.flush();
+				pid_t pid = fork();
+				if (pid < 0) {
+					perror("fork");
+					return 1;
+				}
+				if (pid == 0) {
+					int child_status = 0;
+					try {
+						UREBench ub;
+						(ub.*(w->run))(size, seed);
+					} catch (const std::exception& e) {
+						std::cerr << w->name << " " << size << " " << seed
+						          << ": " << e.what() << std::endl;
+						child_status = 1;
+					}
+					std::cout.flush();
+					_exit(child_status);
+				}
+				int wstatus;
+				waitpid(pid, &wstatus, 0);
+				if (not WIFEXITED(wstatus) or WEXITSTATUS(wstatus) != 0)
+					status = 1;
+			}
+		}
+	}
+	return status;
+}
+
+#undef al
+#undef an
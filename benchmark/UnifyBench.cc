@@ -0,0 +1,308 @@
+/*
+ * UnifyBench.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * Author: agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <opencog/unify/Unify.h>
+#include <opencog/atoms/pattern/BindLink.h>
+#include <opencog/atomspace/AtomSpace.h>
+
+using namespace opencog;
+
+#define al _as->add_link
+#define an _as->add_node
+
+/**
+ * Micro-benchmarks of the unify library over representative
+ * workloads. The timings are printed as
+ *
+ * BENCH <workload> <size> <iterations> <seconds per iteration>
+ *
+ * so that they can be compared across versions. The unification
+ * results are checked as well, any incorrect one is reported and
+ * makes the benchmark fail.
+ */
+class UnifyBench
+{
+public:
+	UnifyBench(size_t iterations);
+
+	void deep_ordered();
+	void unordered_arity();
+	void glob();
+	void typed_variables();
+	void quoted_scope();
+	void substitute();
+
+	// Number of incorrect unification results
+	size_t failures;
+
+private:
+	AtomSpacePtr _as;
+	Handle CT;
+	size_t _iterations;
+
+	// Run f n times and print the average time per run. f returns
+	// false if its result is incorrect.
+	void bench(const std::string& workload, size_t size, size_t n,
+	           const std::function<bool()>& f);
+
+	// Return (Concept "<prefix><i>")
+	Handle concept(const std::string& prefix, size_t i);
+
+	// Return (Variable "$<prefix><i>")
+	Handle variable(const std::string& prefix, size_t i);
+};
+
+UnifyBench::UnifyBench(size_t iterations)
+	: failures(0), _as(createAtomSpace()), _iterations(iterations)
+{
+	CT = an(TYPE_NODE, "ConceptNode");
+}
+
+void UnifyBench::bench(const std::string& workload, size_t size, size_t n,
+                       const std::function<bool()>& f)
+{
+	size_t incorrect = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < n; i++)
+		incorrect += not f();
+	std::chrono::duration<double> elapsed =
+		std::chrono::steady_clock::now() - start;
+	std::cout << "BENCH " << workload << " " << size << " " << n
+	          << " " << elapsed.count() / n << std::endl;
+	if (incorrect) {
+		std::cerr << "FAILED " << workload << " " << size << ": "
+		          << incorrect << " incorrect results" << std::endl;
+		failures += incorrect;
+	}
+}
+
+Handle UnifyBench::concept(const std::string& prefix, size_t i)
+{
+	return an(CONCEPT_NODE, prefix + std::to_string(i));
+}
+
+Handle UnifyBench::variable(const std::string& prefix, size_t i)
+{
+	return an(VARIABLE_NODE, "$" + prefix + std::to_string(i));
+}
+
+/**
+ * Nested ordered links of growing depth, with a variable at each
+ * level on one side and a constant on the other.
+ */
+void UnifyBench::deep_ordered()
+{
+	for (size_t depth : {8, 32, 128}) {
+		Handle lhs = variable("X", 0), rhs = concept("A", 0);
+		for (size_t i = 1; i <= depth; i++) {
+			lhs = al(LIST_LINK, concept("A", i), lhs, variable("X", i));
+			rhs = al(LIST_LINK, variable("Y", i), rhs, concept("A", i));
+		}
+		bench("deep_ordered", depth, _iterations, [&]() {
+				return unifiable(lhs, rhs);
+			});
+	}
+}
+
+/**
+ * Unordered links of growing arity, which exercises
+ * Unify::unordered_unify and join over all permutations. Much
+ * costlier, thus run 10 times less.
+ */
+void UnifyBench::unordered_arity()
+{
+	for (size_t arity : {2, 3, 4, 5}) {
+		HandleSeq lhs_out, rhs_out;
+		for (size_t i = 0; i < arity; i++) {
+			lhs_out.push_back(al(INHERITANCE_LINK, variable("X", i),
+			                     concept("B", i % 2)));
+			rhs_out.push_back(al(INHERITANCE_LINK, concept("A", i),
+			                     variable("Y", i)));
+		}
+		Handle lhs = al(AND_LINK, lhs_out), rhs = al(AND_LINK, rhs_out);
+		bench("unordered_arity", arity, std::max<size_t>(1, _iterations / 10),
+		      [&]() {
+			      Unify unify(lhs, rhs);
+			      return unify().is_satisfiable();
+		      });
+	}
+}
+
+/**
+ * Glob patterns against ordered links of growing arity, which
+ * exercises ordered_unify_glob.
+ */
+void UnifyBench::glob()
+{
+	Handle G = an(GLOB_NODE, "$G"), H = an(GLOB_NODE, "$H");
+	for (size_t arity : {4, 16, 64}) {
+		HandleSeq rhs_out;
+		for (size_t i = 0; i < arity; i++)
+			rhs_out.push_back(concept("A", i));
+		Handle lhs = al(LIST_LINK, G, concept("A", arity / 2), H),
+			rhs = al(LIST_LINK, rhs_out);
+		bench("glob", arity, _iterations, [&]() {
+				Unify unify(lhs, rhs);
+				return unify().is_satisfiable();
+			});
+	}
+}
+
+/**
+ * Ordered links with a growing number of typed variables on both
+ * sides.
+ */
+void UnifyBench::typed_variables()
+{
+	for (size_t n : {4, 16, 64}) {
+		HandleSeq lhs_out, rhs_out, lhs_decls, rhs_decls;
+		for (size_t i = 0; i < n; i++) {
+			Handle X = variable("X", i), Y = variable("Y", i);
+			lhs_out.push_back(i % 2 ? X : concept("A", i));
+			rhs_out.push_back(i % 2 ? concept("A", i) : Y);
+			lhs_decls.push_back(al(TYPED_VARIABLE_LINK, X, CT));
+			rhs_decls.push_back(al(TYPED_VARIABLE_LINK, Y, CT));
+		}
+		Handle lhs = al(LIST_LINK, lhs_out), rhs = al(LIST_LINK, rhs_out),
+			lhs_vardecl = al(VARIABLE_LIST, lhs_decls),
+			rhs_vardecl = al(VARIABLE_LIST, rhs_decls);
+		bench("typed_variables", n, _iterations, [&]() {
+				return unifiable(lhs, rhs, lhs_vardecl, rhs_vardecl);
+			});
+	}
+}
+
+/**
+ * Quoted scope links, as found in meta-rules, with an unquoted
+ * variable declaration and a growing number of unquoted variables
+ * in their bodies, against a lambda whose body alternates its bound
+ * variable and constants.
+ */
+void UnifyBench::quoted_scope()
+{
+	Handle V = an(VARIABLE_NODE, "$V"), Z = an(VARIABLE_NODE, "$Z");
+	for (size_t n : {2, 8, 32}) {
+		HandleSeq lhs_out, rhs_out;
+		for (size_t i = 0; i < n; i++) {
+			lhs_out.push_back(al(UNQUOTE_LINK, variable("X", i)));
+			rhs_out.push_back(i % 2 ? concept("A", i) : Z);
+		}
+		Handle lhs = al(QUOTE_LINK,
+		                al(LAMBDA_LINK, al(UNQUOTE_LINK, V),
+		                   al(LIST_LINK, lhs_out))),
+			rhs = al(LAMBDA_LINK, al(TYPED_VARIABLE_LINK, Z, CT),
+			         al(LIST_LINK, rhs_out));
+		bench("quoted_scope", n, _iterations, [&]() {
+				Unify unify(lhs, rhs);
+				Unify::SolutionSet sol = unify();
+				return sol.is_satisfiable()
+					and not unify.typed_substitutions(sol, lhs).empty();
+			});
+	}
+}
+
+/**
+ * Typed substitutions and substitution over a BindLink, as done by
+ * the chainers to unify a target with a rule conclusion.
+ */
+void UnifyBench::substitute()
+{
+	for (size_t n : {2, 8, 32}) {
+		HandleSeq vardecls, premises, target_out, conclusion_out;
+		for (size_t i = 0; i < n; i++) {
+			Handle X = variable("X", i);
+			vardecls.push_back(al(TYPED_VARIABLE_LINK, X, CT));
+			premises.push_back(al(INHERITANCE_LINK, X, concept("B", i)));
+			target_out.push_back(i % 2 ? concept("A", i) : variable("T", i));
+			conclusion_out.push_back(X);
+		}
+		Handle vardecl = al(VARIABLE_LIST, vardecls),
+			conclusion = al(LIST_LINK, conclusion_out),
+			target = al(LIST_LINK, target_out),
+			bl = al(BIND_LINK, vardecl, al(AND_LINK, premises), conclusion);
+		BindLinkPtr blp(BindLinkCast(bl));
+
+		bench("substitute", n, _iterations, [&]() {
+				Unify unify(target, conclusion, Handle::UNDEFINED, vardecl);
+				Unify::SolutionSet sol = unify();
+				if (not sol.is_satisfiable())
+					return false;
+				Unify::TypedSubstitutions tss =
+					unify.typed_substitutions(sol, target);
+				if (tss.size() != 1)
+					return false;
+				for (const auto& ts : tss)
+					if (Unify::substitute(blp, ts) == Handle::UNDEFINED)
+						return false;
+				return true;
+			});
+	}
+}
+
+/**
+ * Usage: unify-bench [ITERATIONS [WORKLOAD]]
+ *
+ * where WORKLOAD is one of deep_ordered, unordered_arity, glob,
+ * typed_variables, quoted_scope or substitute. All are run if
+ * omitted. Return 1 if any unification result is incorrect.
+ */
+int main(int argc, char** argv)
+{
+	size_t iterations = argc > 1 ? std::stoul(argv[1]) : 100;
+	std::string workload = argc > 2 ? argv[2] : "";
+
+	UnifyBench ub(iterations);
+	std::vector<std::pair<std::string, std::function<void()>>> workloads{
+		{"deep_ordered", [&]() { ub.deep_ordered(); }},
+		{"unordered_arity", [&]() { ub.unordered_arity(); }},
+		{"glob", [&]() { ub.glob(); }},
+		{"typed_variables", [&]() { ub.typed_variables(); }},
+		{"quoted_scope", [&]() { ub.quoted_scope(); }},
+		{"substitute", [&]() { ub.substitute(); }}};
+
+	bool known = workload.empty()
+		or std::any_of(workloads.begin(), workloads.end(),
+		               [&](const auto& w) { return w.first == workload; });
+	if (iterations == 0 or not known) {
+		std::cerr << "Usage: " << argv[0]
+		          << " [ITERATIONS [WORKLOAD]]" << std::endl;
+		return 1;
+	}
+
+	for (const auto& w : workloads)
+		if (workload.empty() or workload == w.first)
+			w.second();
+
+	return ub.failures ? 1 : 0;
+}
+
+#undef al
+#undef an
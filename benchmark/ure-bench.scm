@@ -0,0 +1,107 @@
+;;
+;; ure-bench.scm
+;;
+;;;; Commentary:
+;;
+;; Synthetic knowledge and rule bases for ure-bench, see UREBench.cc.
+;;
+;; Knowledge bases are generated with a given size, and for the random
+;; ones a given seed, so that the benchmarks are repeatable.
+;;
+;;;; Code:
+;; Copyright (c) 2026, OpenCog Foundation
+;;
+
+(use-modules (srfi srfi-1))
+(use-modules (opencog))
+(use-modules (opencog ure))
+
+;; Useful to run the unit tests without having to install opencog
+(load-from-path "ure-utils.scm")
+
+;;;;;;;;;;;;;;;;
+;; Load rules ;;
+;;;;;;;;;;;;;;;;
+(load-from-path "tests/ure/rules/fc-deduction-rule.scm")
+(load-from-path "tests/ure/rules/bc-deduction-rule.scm")
+(load-from-path "tests/ure/rules/crisp-modus-ponens-rule.scm")
+(load-from-path "tests/ure/rules/fuzzy-conjunction-introduction-rule.scm")
+
+;;;;;;;;;;;;;;;;
+;; Rule bases ;;
+;;;;;;;;;;;;;;;;
+
+;; The termination criteria are set by the benchmarks themselves
+(define bench-fc-deduction-rbs (Concept "bench-fc-deduction-rbs"))
+(ure-add-rules bench-fc-deduction-rbs (list fc-deduction-rule-name))
+
+(define bench-bc-deduction-rbs (Concept "bench-bc-deduction-rbs"))
+(ure-add-rules bench-bc-deduction-rbs (list bc-deduction-rule-name))
+
+(define bench-modus-ponens-rbs (Concept "bench-modus-ponens-rbs"))
+(ure-add-rules bench-modus-ponens-rbs (list crisp-modus-ponens-rule-name))
+
+(define bench-conjunction-rbs (Concept "bench-conjunction-rbs"))
+(ure-add-rules bench-conjunction-rbs
+               (list fuzzy-conjunction-introduction-2ary-rule-name
+                     fuzzy-conjunction-introduction-3ary-rule-name))
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+;; Knowledge base generators               ;;
+;;                                         ;;
+;; Each returns a SetLink of the generated ;;
+;; axioms, to be used as sources.          ;;
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+
+;; Return (Concept "C-i")
+(define (bench-concept i)
+  (Concept (string-append "C-" (number->string i))))
+
+;; Return (Predicate "P-i")
+(define (bench-predicate i)
+  (Predicate (string-append "P-" (number->string i))))
+
+;; Return a list of m random pairs of distinct integers in [0, n)
+(define (random-pairs n m seed)
+  (let ((state (seed->random-state seed)))
+    (define (random-pair)
+      (let ((i (random n state))
+            (j (random n state)))
+        (if (= i j) (random-pair) (cons i j))))
+    (map (lambda (k) (random-pair)) (iota m))))
+
+;; Inheritance chain C-0 -> C-1 -> ... -> C-n
+(define (gen-inheritance-chain n)
+  (Set
+    (map (lambda (i)
+           (Inheritance (stv 1 1) (bench-concept i) (bench-concept (+ i 1))))
+         (iota n))))
+
+;; Random inheritance graph of n concepts and m edges
+(define (gen-inheritance-graph n m seed)
+  (Set
+    (map (lambda (p)
+           (Inheritance (stv 1 1) (bench-concept (car p)) (bench-concept (cdr p))))
+         (random-pairs n m seed))))
+
+;; Random modus ponens network of n predicates and m implications,
+;; where P-0 is true, plus the implication chain P-0 -> ... -> P-(n-1)
+;; so that every predicate can be reached.
+(define (gen-implication-network n m seed)
+  (cog-set-tv! (bench-predicate 0) (stv 1 1))
+  (Set
+    (map (lambda (p)
+           (Implication (stv 1 1) (bench-predicate (car p)) (bench-predicate (cdr p))))
+         (append (map (lambda (i) (cons i (+ i 1))) (iota (- n 1)))
+                 (random-pairs n m seed)))))
+
+;; Evaluations of n predicates over the same concept, with
+;; pseudo-random truth values, for conjunction introduction.
+(define (gen-evaluations n seed)
+  (let ((state (seed->random-state seed)))
+    (Set
+      (map (lambda (i)
+             (Evaluation (stv (random:uniform state) 0.9)
+               (bench-predicate i)
+               (bench-concept 0)))
+           (iota n)))))
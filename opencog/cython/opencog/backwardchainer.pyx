@@ -1,8 +1,12 @@
-from cython.operator cimport dereference as deref
+from cython.operator cimport dereference as deref, preincrement as inc
+from libcpp.map cimport map
+from libcpp.string cimport string
 from opencog.atomspace cimport Atom
 from opencog.atomspace cimport cHandle, AtomSpace, TruthValue
 from opencog.atomspace import types
-from ure cimport cBackwardChainer
+from libcpp.pair cimport pair
+from libcpp.vector cimport vector
+from ure cimport cBackwardChainer, cTiming
 
 # Create a Cython extension type which holds a C++ instance
 # as an attribute and create a bunch of forwarding methods
@@ -51,6 +55,48 @@ cdef class BackwardChainer:
         cdef Atom result = Atom.createAtom(res_handle)
         return result
 
+    def get_phase_times(self):
+        """
+        Return a dict mapping each phase of the last do_chain call to the
+        pair (seconds, count), the time spent in it and the number of times
+        it has been entered. Empty unless URE:phase-timing is enabled.
+        """
+        cdef map[string, cTiming] timings = self.chainer.get_phase_timers().get_timings()
+        cdef map[string, cTiming].iterator it = timings.begin()
+        result = {}
+        while it != timings.end():
+            result[deref(it).first.decode('utf-8')] = (deref(it).second.seconds,
+                                                       deref(it).second.count)
+            inc(it)
+        return result
+
+    def get_stats(self):
+        """
+        Return a dict mapping each counter of the last do_chain call, such
+        as unifications_attempted or rule_applications, to its value, see
+        ChainerStats.
+        """
+        cdef vector[pair[string, size_t]] counts = self.chainer.get_stats().get_counts()
+        result = {}
+        for i in range(counts.size()):
+            result[counts[i].first.decode('utf-8')] = counts[i].second
+        return result
+
+    def load_action_statistics(self, filename):
+        """
+        Load the success counts of the inference rules from a file saved
+        by save_action_statistics, to warm start do_chain.
+        """
+        self.chainer.get_action_statistics().load(filename.encode('utf-8'),
+                                                  deref(self._as.atomspace))
+
+    def save_action_statistics(self, filename):
+        """
+        Save the success counts of the inference rules, gathered by
+        do_chain if URE:BC:online-action-statistics is enabled, to a file.
+        """
+        self.chainer.get_action_statistics().save(filename.encode('utf-8'))
+
     def __dealloc__(self):
         del self.chainer
         self._trace_as = None
@@ -1,7 +1,11 @@
 from opencog.atomspace import types
 from cython.operator cimport dereference as deref, preincrement as inc
 from opencog.atomspace cimport cHandle, Atom, AtomSpace, TruthValue
-from ure cimport cForwardChainer
+from libcpp.map cimport map
+from libcpp.string cimport string
+from libcpp.pair cimport pair
+from libcpp.vector cimport vector
+from ure cimport cForwardChainer, cTiming
 
 # Create a Cython extension type which holds a C++ instance
 # as an attribute and create a bunch of forwarding methods
@@ -47,6 +51,42 @@ cdef class ForwardChainer:
         cdef Atom result = Atom.createAtom(res_handle)
         return result
 
+    def set_product_callback(self, Atom schema):
+        """
+        Register a grounded schema, such as GroundedSchemaNode("py: consume"),
+        executed over a SetLink of the products of each rule application as
+        soon as they are derived. If the products are all consumed that way,
+        get_results need not be called.
+        """
+        self.chainer.set_product_callback(deref(schema.handle))
+
+    def get_phase_times(self):
+        """
+        Return a dict mapping each phase of the last do_chain call to the
+        pair (seconds, count), the time spent in it and the number of times
+        it has been entered. Empty unless URE:phase-timing is enabled.
+        """
+        cdef map[string, cTiming] timings = self.chainer.get_phase_timers().get_timings()
+        cdef map[string, cTiming].iterator it = timings.begin()
+        result = {}
+        while it != timings.end():
+            result[deref(it).first.decode('utf-8')] = (deref(it).second.seconds,
+                                                       deref(it).second.count)
+            inc(it)
+        return result
+
+    def get_stats(self):
+        """
+        Return a dict mapping each counter of the last do_chain call, such
+        as unifications_attempted or rule_applications, to its value, see
+        ChainerStats.
+        """
+        cdef vector[pair[string, size_t]] counts = self.chainer.get_stats().get_counts()
+        result = {}
+        for i in range(counts.size()):
+            result[counts[i].first.decode('utf-8')] = counts[i].second
+        return result
+
     def __dealloc__(self):
         del self.chainer
         self._trace_as = None
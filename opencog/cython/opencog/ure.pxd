@@ -1,9 +1,36 @@
+from libcpp cimport bool
+from libcpp.map cimport map
+from libcpp.pair cimport pair
 from libcpp.set cimport set
+from libcpp.string cimport string
 from libcpp.vector cimport vector
 from opencog.atomspace cimport cHandle, cAtomSpace
 from opencog.logger cimport cLogger
 
 
+cdef extern from "opencog/ure/PhaseTimers.h" namespace "opencog":
+    cdef cppclass cTiming "opencog::PhaseTimers::Timing":
+        double seconds
+        size_t count
+
+    cdef cppclass cPhaseTimers "opencog::PhaseTimers":
+        bool is_enabled() const
+        map[string, cTiming] get_timings() const
+
+
+cdef extern from "opencog/ure/ChainerStats.h" namespace "opencog":
+    cdef cppclass cChainerStats "opencog::ChainerStats":
+        vector[pair[string, size_t]] get_counts() const
+        string to_json() const
+
+
+cdef extern from "opencog/ure/ActionStatistics.h" namespace "opencog":
+    cdef cppclass cActionStatistics "opencog::ActionStatistics":
+        size_t size() const
+        void save(const string& filename) except +
+        void load(const string& filename, cAtomSpace& _as) except +
+
+
 cdef extern from "opencog/ure/forwardchainer/ForwardChainer.h" namespace "opencog":
     cdef cppclass cForwardChainer "opencog::ForwardChainer":
         cForwardChainer(cAtomSpace& kb_as,
@@ -16,6 +43,9 @@ cdef extern from "opencog/ure/forwardchainer/ForwardChainer.h" namespace "openco
 
         void do_chain() except +
         cHandle get_results() const
+        void set_product_callback(const cHandle& schema)
+        const cPhaseTimers& get_phase_timers() const
+        const cChainerStats& get_stats() const
 
 
 cdef extern from "opencog/ure/backwardchainer/Fitness.h" namespace "opencog::BITNodeFitness":
@@ -70,6 +100,9 @@ cdef extern from "opencog/ure/backwardchainer/BackwardChainer.h" namespace "open
 
         void do_chain() except +
         cHandle get_results() const
+        const cPhaseTimers& get_phase_timers() const
+        const cChainerStats& get_stats() const
+        cActionStatistics& get_action_statistics()
 
 
 cdef extern from "opencog/ure/URELogger.h" namespace "opencog":
@@ -28,11 +28,22 @@
 ;; -- ure-set-complexity-penalty -- Set the URE:complexity-penalty parameter
 ;; -- ure-set-jobs -- Set the URE:jobs parameter
 ;; -- ure-set-expansion-pool-size -- Set the URE:expansion-pool-size parameter
+;; -- ure-set-selection-policy -- Set the URE:selection-policy parameter
+;; -- ure-set-tournament-size -- Set the URE:tournament-size parameter
+;; -- ure-set-unification-cache-size -- Set the URE:unification-cache-size parameter
+;; -- ure-set-phase-timing -- Set the URE:phase-timing parameter
 ;; -- ure-set-fc-retry-exhausted-sources -- Set the URE:FC:retry-exhausted-sources parameter
 ;; -- ure-set-fc-full-rule-application -- Set the URE:FC:full-rule-application parameter
+;; -- ure-set-fc-semi-naive-rule-application -- Set the URE:FC:semi-naive-rule-application parameter
+;; -- ure-set-fc-rete-rule-application -- Set the URE:FC:rete-rule-application parameter
+;; -- ure-set-fc-maximum-expansion-pool-size -- Set the URE:FC:maximum-expansion-pool-size parameter
+;; -- ure-set-fc-maximum-inference-records -- Set the URE:FC:maximum-inference-records parameter
 ;; -- ure-set-bc-maximum-bit-size -- Set the URE:BC:maximum-bit-size
 ;; -- ure-set-bc-mm-complexity-penalty -- Set the URE:BC:MM:complexity-penalty
 ;; -- ure-set-bc-mm-compressiveness -- Set the URE:BC:MM:compressiveness
+;; -- ure-set-bc-online-action-statistics -- Set the URE:BC:online-action-statistics
+;; -- ure-phase-times -- Get the time spent in each phase of the last chainer call with a rbs
+;; -- ure-chainer-stats -- Get the statistics of the last chainer call with a rbs
 ;; -- ure-define-rbs -- Create a rbs that runs for a particular number of
 ;;                      iterations.
 ;; -- ure-logger-set-level! -- Set level of the URE logger
@@ -95,8 +106,19 @@
                  (complexity-penalty *unspecified*)
                  (jobs *unspecified*)
                  (expansion-pool-size *unspecified*)
+                 (selection-policy *unspecified*)
+                 (tournament-size *unspecified*)
+                 (unification-cache-size *unspecified*)
+                 (phase-timing *unspecified*)
                  (fc-retry-exhausted-sources *unspecified*)
-                 (fc-full-rule-application *unspecified*))
+                 (fc-full-rule-application *unspecified*)
+                 (fc-semi-naive-rule-application *unspecified*)
+                 (fc-rete-rule-application *unspecified*)
+                 (fc-maximum-expansion-pool-size *unspecified*)
+                 (fc-maximum-inference-records *unspecified*)
+                 (product-callback (List))
+                 (results-set #t)
+                 (chainer-stats #f))
 "
   Forward Chainer call.
 
@@ -109,8 +131,19 @@
                  #:complexity-penalty cp
                  #:jobs jb
                  #:expansion-pool-size esp
+                 #:selection-policy sp
+                 #:tournament-size ts
+                 #:unification-cache-size ucs
+                 #:phase-timing pt
                  #:fc-retry-exhausted-sources res
-                 #:fc-full-rule-application fra)
+                 #:fc-full-rule-application fra
+                 #:fc-semi-naive-rule-application snra
+                 #:fc-rete-rule-application rra
+                 #:fc-maximum-expansion-pool-size meps
+                 #:fc-maximum-inference-records mir
+                 #:product-callback pc
+                 #:results-set rs
+                 #:chainer-stats cs)
 
   rbs: ConceptNode representing a rulebase.
 
@@ -144,6 +177,24 @@
        the forward chainer), but also then the selection is more costly.
        Negative or null means unlimited (not recommended).
 
+  sp: [optional, default='thompson-sampling] Policy used to select the
+      next rule or expansion. Can be 'thompson-sampling,
+      'single-draw-thompson-sampling, 'bayes-ucb or 'tournament. The
+      latter ones are cheaper, especially with many rules or a large
+      expansion pool.
+
+  ts: [optional, default=2] Number of contenders when the selection
+      policy is 'tournament.
+
+  ucs: [optional, default=0] Maximum number of unification results
+       cached, and reused across the steps of the chainer. Each chainer
+       has its own cache, freed with it. Zero disables it.
+
+  pt: [optional, default=#f] Whether to measure the time spent in each
+      phase of the chainer. If so it is attached to rbs, replacing the one
+      of the previous call with rbs, and can be retrieved with
+      ure-phase-times, even if no results are returned.
+
   res: [optional, default=#f] Whether exhausted sources should be
        retried. A source is exhausted if all its valid rules (so that at
        least one rule premise unifies with the source) have been applied to
@@ -155,6 +206,43 @@
        entire atomspace, not just the source. This can be convienient if
        the goal is to rapidly achieve inference closure.
 
+  snra: [optional, default=#f] Whether a rule applied over the entire
+        atomspace (see fra) is only matched against groundings involving
+        at least one atom derived since its last application, rather than
+        re-deriving everything at each application.
+
+  rra: [optional, default=#f] Whether rules applied over the entire
+       atomspace (see fra) are compiled into a Rete-style network, fed by
+       the derived atoms, so that each application only produces new
+       matches. Takes precedence over snra.
+
+  meps: [optional, default=-1] Maximum number of (source, rule) pairs the
+        expansion pool can hold, the least promising ones being set aside
+        beyond it, to be re-admitted when room is made or when they
+        outrank the pairs of the pool. Allows to use an unlimited
+        expansion pool size while keeping selection cheap. Negative means
+        unlimited.
+
+  mir: [optional, default=-1] Maximum number of inference records kept in
+       memory, the oldest being discarded beyond it. Zero means only their
+       counts are kept, negative means all of them are. Does not affect the
+       results, nor the traces recorded in tas.
+
+  pc: [optional] GroundedSchemaNode, such as
+      (GroundedSchemaNode \"scm: consume\"), called with a SetLink of the
+      products of each rule application as soon as they are derived, so
+      that they can be consumed while forward chaining is running. Like
+      any grounded schema it should return an atom.
+
+  rs: [optional, default=#t] Whether to return a SetLink of all the
+      results once forward chaining has terminated. Can be disabled when
+      the products are consumed by pc, in which case '() is returned.
+
+  cs: [optional, default=#f] Whether to attach the counts of
+      unifications, rule applications, etc, of the call to rbs, like pt,
+      to be retrieved with ure-chainer-stats. If not, the counts of the
+      previous call with rbs are removed.
+
   Note that the defaults of the optional arguments are not determined
   here (although they attempt to be documented here).  That is the case
   in order not to overwrite existing parameters set by
@@ -173,15 +261,32 @@
       (ure-set-jobs rbs jobs))
   (if (not (unspecified? expansion-pool-size))
       (ure-set-expansion-pool-size rbs expansion-pool-size))
+  (if (not (unspecified? selection-policy))
+      (ure-set-selection-policy rbs selection-policy))
+  (if (not (unspecified? tournament-size))
+      (ure-set-tournament-size rbs tournament-size))
+  (if (not (unspecified? unification-cache-size))
+      (ure-set-unification-cache-size rbs unification-cache-size))
+  (if (not (unspecified? phase-timing))
+      (ure-set-phase-timing rbs phase-timing))
   (if (not (unspecified? fc-retry-exhausted-sources))
       (ure-set-fc-retry-exhausted-sources rbs fc-retry-exhausted-sources))
   (if (not (unspecified? fc-full-rule-application))
       (ure-set-fc-full-rule-application rbs fc-full-rule-application))
+  (if (not (unspecified? fc-semi-naive-rule-application))
+      (ure-set-fc-semi-naive-rule-application rbs fc-semi-naive-rule-application))
+  (if (not (unspecified? fc-rete-rule-application))
+      (ure-set-fc-rete-rule-application rbs fc-rete-rule-application))
+  (if (not (unspecified? fc-maximum-expansion-pool-size))
+      (ure-set-fc-maximum-expansion-pool-size rbs fc-maximum-expansion-pool-size))
+  (if (not (unspecified? fc-maximum-inference-records))
+      (ure-set-fc-maximum-inference-records rbs fc-maximum-inference-records))
 
   ;; Defined optional atomspaces and call the forward chainer
   (let* ((trace-enabled (cog-atomspace? trace-as))
          (tas (if trace-enabled trace-as (cog-atomspace))))
-    (cog-mandatory-args-fc rbs source vardecl trace-enabled tas focus-set)))
+    (cog-mandatory-args-fc rbs source vardecl trace-enabled tas focus-set
+                           product-callback results-set chainer-stats)))
 
 (define* (cog-bc rbs target
                  #:key
@@ -194,9 +299,17 @@
                  (complexity-penalty *unspecified*)
                  (jobs *unspecified*)
                  (expansion-pool-size *unspecified*)
+                 (selection-policy *unspecified*)
+                 (tournament-size *unspecified*)
+                 (unification-cache-size *unspecified*)
+                 (phase-timing *unspecified*)
                  (bc-maximum-bit-size *unspecified*)
                  (bc-mm-complexity-penalty *unspecified*)
-                 (bc-mm-compressiveness *unspecified*))
+                 (bc-mm-compressiveness *unspecified*)
+                 (bc-online-action-statistics *unspecified*)
+                 (load-action-statistics "")
+                 (save-action-statistics "")
+                 (chainer-stats #f))
 "
   Backward Chainer call.
 
@@ -210,9 +323,17 @@
                  #:complexity-penalty cp
                  #:jobs jb
                  #:expansion-pool-size esp
+                 #:selection-policy sp
+                 #:tournament-size ts
+                 #:unification-cache-size ucs
+                 #:phase-timing pt
                  #:bc-maximum-bit-size mbs
                  #:bc-mm-complexity-penalty mcp
-                 #:bc-mm-compressiveness mc)
+                 #:bc-mm-compressiveness mc
+                 #:bc-online-action-statistics oas
+                 #:load-action-statistics las
+                 #:save-action-statistics sas
+                 #:chainer-stats cs)
 
   rbs: ConceptNode representing a rulebase.
 
@@ -247,6 +368,24 @@
        the forward chainer), but also then the selection is more costly.
        Negative or null means unlimited (not recommended).
 
+  sp: [optional, default='thompson-sampling] Policy used to select the
+      next rule or expansion. Can be 'thompson-sampling,
+      'single-draw-thompson-sampling, 'bayes-ucb or 'tournament. The
+      latter ones are cheaper, especially with many rules or a large
+      expansion pool.
+
+  ts: [optional, default=2] Number of contenders when the selection
+      policy is 'tournament.
+
+  ucs: [optional, default=0] Maximum number of unification results
+       cached, and reused across the steps of the chainer. Each chainer
+       has its own cache, freed with it. Zero disables it.
+
+  pt: [optional, default=#f] Whether to measure the time spent in each
+      phase of the chainer. If so it is attached to rbs, replacing the one
+      of the previous call with rbs, and can be retrieved with
+      ure-phase-times, even if no results are returned.
+
   mbs: [optional, default=-1] Maximum size of the inference tree pool
        to evolve. Negative means unlimited.
 
@@ -257,6 +396,23 @@
       control rules (how well a control rule can explain data outside of its
       context).
 
+  oas: [optional, default=#f] Whether the success counts of the inference
+       rules, gathered from the proofs found so far, are used in addition
+       to the rule TVs to select rules for expansion.
+
+  las: [optional] File from which to load the success counts of the
+       inference rules, as saved by a previous call with sas, before
+       backward chaining.
+
+  sas: [optional] File where to save the success counts of the
+       inference rules once backward chaining has terminated. They are
+       only gathered if oas is enabled.
+
+  cs: [optional, default=#f] Whether to attach the counts of
+      unifications, rule applications, etc, of the call to rbs, like pt,
+      to be retrieved with ure-chainer-stats. If not, the counts of the
+      previous call with rbs are removed.
+
   Note that the defaults of the optional arguments are not determined
   here (although they attempt to be documented here).  That is the case
   in order not to overwrite existing parameters set by
@@ -275,12 +431,22 @@
       (ure-set-jobs rbs jobs))
   (if (not (unspecified? expansion-pool-size))
       (ure-set-expansion-pool-size rbs expansion-pool-size))
+  (if (not (unspecified? selection-policy))
+      (ure-set-selection-policy rbs selection-policy))
+  (if (not (unspecified? tournament-size))
+      (ure-set-tournament-size rbs tournament-size))
+  (if (not (unspecified? unification-cache-size))
+      (ure-set-unification-cache-size rbs unification-cache-size))
+  (if (not (unspecified? phase-timing))
+      (ure-set-phase-timing rbs phase-timing))
   (if (not (unspecified? bc-maximum-bit-size))
       (ure-set-bc-maximum-bit-size rbs bc-maximum-bit-size))
   (if (not (unspecified? bc-mm-complexity-penalty))
       (ure-set-bc-mm-complexity-penalty rbs bc-mm-complexity-penalty))
   (if (not (unspecified? bc-mm-compressiveness))
       (ure-set-bc-mm-compressiveness rbs bc-mm-compressiveness))
+  (if (not (unspecified? bc-online-action-statistics))
+      (ure-set-bc-online-action-statistics rbs bc-online-action-statistics))
 
   ;; Defined optional atomspaces and call the backward chainer
   (let* ((trace-enabled (cog-atomspace? trace-as))
@@ -288,7 +454,9 @@
          (tas (if trace-enabled trace-as (cog-atomspace)))
          (cas (if control-enabled control-as (cog-atomspace))))
     (cog-mandatory-args-bc rbs target vardecl
-                           trace-enabled tas control-enabled cas focus-set)))
+                           trace-enabled tas control-enabled cas focus-set
+                           load-action-statistics save-action-statistics
+                           chainer-stats)))
 
 (set-procedure-property! cog-ure-logger 'documentation
 "
@@ -849,6 +1017,74 @@
 "
   (ure-set-num-parameter rbs "URE:expansion-pool-size" value))
 
+(define (ure-set-selection-policy rbs value)
+"
+  Set the URE:selection-policy parameter of a given RBS
+
+  ExecutionLink
+    SchemaNode \"URE:selection-policy\"
+    rbs
+    NumberNode value
+
+  where value is either a number or one of the following symbols
+
+  'thompson-sampling             (0)
+  'single-draw-thompson-sampling (1)
+  'bayes-ucb                     (2)
+  'tournament                    (3)
+
+  Delete any previous one if exists.
+"
+  (define policy
+    (if (number? value)
+        value
+        (case value
+          ((thompson-sampling) 0)
+          ((single-draw-thompson-sampling) 1)
+          ((bayes-ucb) 2)
+          ((tournament) 3)
+          (else (error "Unknown selection policy:" value)))))
+  (ure-set-num-parameter rbs "URE:selection-policy" policy))
+
+(define (ure-set-tournament-size rbs value)
+"
+  Set the URE:tournament-size parameter of a given RBS
+
+  ExecutionLink
+    SchemaNode \"URE:tournament-size\"
+    rbs
+    NumberNode value
+
+  Delete any previous one if exists.
+"
+  (ure-set-num-parameter rbs "URE:tournament-size" value))
+
+(define (ure-set-unification-cache-size rbs value)
+"
+  Set the URE:unification-cache-size parameter of a given RBS
+
+  ExecutionLink
+    SchemaNode \"URE:unification-cache-size\"
+    rbs
+    NumberNode value
+
+  Delete any previous one if exists.
+"
+  (ure-set-num-parameter rbs "URE:unification-cache-size" value))
+
+(define (ure-set-phase-timing rbs value)
+"
+  Set the URE:phase-timing parameter of a given RBS
+
+  EvaluationLink (stv value 1)
+    PredicateNode \"URE:phase-timing\"
+    rbs
+
+  If the provided value is a boolean, then it is automatically
+  converted into tv.
+"
+  (ure-set-fuzzy-bool-parameter rbs "URE:phase-timing" value))
+
 (define (ure-set-fc-retry-exhausted-sources rbs value)
 "
   Set the URE:FC:retry-exhausted-sources parameter of a given RBS
@@ -875,6 +1111,58 @@
 "
   (ure-set-fuzzy-bool-parameter rbs "URE:FC:full-rule-application" value))
 
+(define (ure-set-fc-semi-naive-rule-application rbs value)
+"
+  Set the URE:FC:semi-naive-rule-application parameter of a given RBS
+
+  EvaluationLink (stv value 1)
+    PredicateNode \"URE:FC:semi-naive-rule-application\"
+    rbs
+
+  If the provided value is a boolean, then it is automatically
+  converted into tv.
+"
+  (ure-set-fuzzy-bool-parameter rbs "URE:FC:semi-naive-rule-application" value))
+
+(define (ure-set-fc-rete-rule-application rbs value)
+"
+  Set the URE:FC:rete-rule-application parameter of a given RBS
+
+  EvaluationLink (stv value 1)
+    PredicateNode \"URE:FC:rete-rule-application\"
+    rbs
+
+  If the provided value is a boolean, then it is automatically
+  converted into tv.
+"
+  (ure-set-fuzzy-bool-parameter rbs "URE:FC:rete-rule-application" value))
+
+(define (ure-set-fc-maximum-expansion-pool-size rbs value)
+"
+  Set the URE:FC:maximum-expansion-pool-size parameter of a given RBS
+
+  ExecutionLink
+    SchemaNode \"URE:FC:maximum-expansion-pool-size\"
+    rbs
+    NumberNode value
+
+  Delete any previous one if exists.
+"
+  (ure-set-num-parameter rbs "URE:FC:maximum-expansion-pool-size" value))
+
+(define (ure-set-fc-maximum-inference-records rbs value)
+"
+  Set the URE:FC:maximum-inference-records parameter of a given RBS
+
+  ExecutionLink
+    SchemaNode \"URE:FC:maximum-inference-records\"
+    rbs
+    NumberNode value
+
+  Delete any previous one if exists.
+"
+  (ure-set-num-parameter rbs "URE:FC:maximum-inference-records" value))
+
 (define (ure-set-bc-maximum-bit-size rbs value)
 "
   Set the URE:BC:maximum-bit-size parameter of a given RBS
@@ -914,6 +1202,54 @@
 "
   (ure-set-num-parameter rbs "URE:BC:MM:compressiveness" value))
 
+(define (ure-set-bc-online-action-statistics rbs value)
+"
+  Set the URE:BC:online-action-statistics parameter of a given RBS
+
+  EvaluationLink (stv value 1)
+    PredicateNode \"URE:BC:online-action-statistics\"
+    rbs
+
+  If the provided value is a boolean, then it is automatically
+  converted into tv.
+"
+  (ure-set-fuzzy-bool-parameter rbs "URE:BC:online-action-statistics" value))
+
+(define (ure-phase-times rbs)
+"
+  Return the time spent in each phase of the last chainer call with
+  the rule base rbs, as a list of
+
+  (phase seconds count)
+
+  where count is the number of times the phase has been entered.
+  Return the empty list if URE:phase-timing was not enabled for that
+  call, see ure-set-phase-timing.
+"
+  (let ((times (cog-value rbs (Predicate "URE:phase-times"))))
+    (if (or (not times) (null? times))
+        '()
+        (let ((vals (map cog-value->list (cog-value->list times))))
+          (map list (first vals) (second vals) (third vals))))))
+
+(define (ure-chainer-stats rbs)
+"
+  Return the statistics of the last chainer call with the rule base
+  rbs, such as the numbers of unifications, rule applications or
+  and-BITs created, as an association list of
+
+  (counter . value)
+
+  for instance (\"unifications_attempted\" . 42). Return the empty
+  list if #:chainer-stats was not enabled for that call, see cog-fc
+  and cog-bc.
+"
+  (let ((stats (cog-value rbs (Predicate "URE:chainer-stats"))))
+    (if (or (not stats) (null? stats))
+        '()
+        (let ((vals (map cog-value->list (cog-value->list stats))))
+          (map cons (first vals) (map inexact->exact (second vals)))))))
+
 (define-public (ure-define-rbs rbs iteration)
 "
   Transforms the atom into a node that represents a rulebase and returns it.
@@ -1300,11 +1636,22 @@
           ure-set-complexity-penalty
           ure-set-jobs
           ure-set-expansion-pool-size
+          ure-set-selection-policy
+          ure-set-tournament-size
+          ure-set-unification-cache-size
+          ure-set-phase-timing
           ure-set-fc-retry-exhausted-sources
           ure-set-fc-full-rule-application
+          ure-set-fc-semi-naive-rule-application
+          ure-set-fc-rete-rule-application
+          ure-set-fc-maximum-expansion-pool-size
+          ure-set-fc-maximum-inference-records
           ure-set-bc-maximum-bit-size
           ure-set-bc-mm-complexity-penalty
           ure-set-bc-mm-compressiveness
+          ure-set-bc-online-action-statistics
+          ure-phase-times
+          ure-chainer-stats
           ure-define-rbs
           ure-get-forward-rule
           ure-logger-set-level!
@@ -25,7 +25,8 @@
 
 #include "Unify.h"
 
-#include <boost/algorithm/cxx11/any_of.hpp>
+#include <algorithm>
+#include <unordered_map>
 
 #include <opencog/util/algorithm.h>
 #include <opencog/util/Logger.h>
@@ -173,25 +174,13 @@ void Unify::SolutionSet::remove_cycles()
 
 Unify::Unify(const Handle& lhs, const Handle& rhs,
              const Handle& lhs_vardecl, const Handle& rhs_vardecl)
-{
-	// Set terms to unify
-	_lhs = lhs;
-	_rhs = rhs;
-
-	// Set _variables
-	set_variables(lhs, rhs, lhs_vardecl, rhs_vardecl);
-}
+	: _lhs(lhs), _rhs(rhs),
+	  _variables(gen_variables(lhs, rhs, lhs_vardecl, rhs_vardecl)) {}
 
 Unify::Unify(const Handle& lhs, const Handle& rhs,
              const Variables& lhs_vars, const Variables& rhs_vars)
-{
-	// Set terms to unify
-	_lhs = lhs;
-	_rhs = rhs;
-
-	// Set _variables
-	_variables = merge_variables(lhs_vars, rhs_vars);
-}
+	: _lhs(lhs), _rhs(rhs),
+	  _variables(merge_variables(lhs_vars, rhs_vars)) {}
 
 Unify::TypedSubstitutions Unify::typed_substitutions(const SolutionSet& sol,
                                                      const Handle& pre) const
@@ -249,13 +238,14 @@ static Variables gen_univars(const Handle& h, const Handle& vardecl)
 	return Variables(varli);
 }
 
-void Unify::set_variables(const Handle& lhs, const Handle& rhs,
-                          const Handle& lhs_vardecl, const Handle& rhs_vardecl)
+Variables Unify::gen_variables(const Handle& lhs, const Handle& rhs,
+                               const Handle& lhs_vardecl,
+                               const Handle& rhs_vardecl)
 {
 	// Merge the 2 type declarations
 	Variables lv = gen_univars(lhs, lhs_vardecl);
 	Variables rv = gen_univars(rhs, rhs_vardecl);
-	_variables = merge_variables(lv, rv);
+	return merge_variables(lv, rv);
 }
 
 Unify::CHandle Unify::find_least_abstract(const TypedBlock& block,
@@ -380,27 +370,66 @@ bool Unify::has_cycle(const Block& blk)
 
 bool Unify::has_cycle(const HandleMultimap& vg)
 {
-	using boost::algorithm::any_of;
-	HandleMultimap cvg = closure(vg);
-	return any_of(cvg, [](const HandleMultimap::value_type& vvs) {
-			return contains(vvs.second, vvs.first); });
+	// Iterative depth first search, reaching a variable that is still
+	// on the current path means there is a cycle. Each variable and
+	// edge is visited once.
+	struct Frame
+	{
+		Handle var;
+		HandleSet::const_iterator it;
+		HandleSet::const_iterator end;
+	};
+	std::unordered_map<Handle, bool> on_path;
+	std::vector<Frame> stack;
+	for (const auto& vvs : vg) {
+		if (on_path.find(vvs.first) != on_path.end())
+			continue;
+		on_path[vvs.first] = true;
+		stack.push_back({vvs.first, vvs.second.cbegin(), vvs.second.cend()});
+		while (not stack.empty()) {
+			Frame& top = stack.back();
+			if (top.it == top.end) {
+				on_path[top.var] = false;
+				stack.pop_back();
+				continue;
+			}
+			Handle var = *(top.it++);
+			auto opit = on_path.find(var);
+			if (opit != on_path.end()) {
+				if (opit->second)
+					return true;
+				continue;
+			}
+			auto vgit = vg.find(var);
+			if (vgit == vg.end()) {
+				on_path[var] = false;
+				continue;
+			}
+			on_path[var] = true;
+			stack.push_back({var, vgit->second.cbegin(), vgit->second.cend()});
+		}
+	}
+	return false;
 }
 
 HandleMultimap Unify::closure(const HandleMultimap& vg)
 {
-	return fixpoint(&Unify::closure_step, vg);
-}
-
-HandleMultimap Unify::closure_step(const HandleMultimap& vg)
-{
-	HandleMultimap nvg(vg);
+	HandleMultimap cvg;
 	for (const auto& vvs : vg) {
-		for (const Handle& v : vvs.second) {
-			const HandleSet& third = nvg[v];
-			nvg[vvs.first].insert(third.begin(), third.end());
+		HandleSet& reached = cvg[vvs.first];
+		HandleSeq to_visit(vvs.second.begin(), vvs.second.end());
+		while (not to_visit.empty()) {
+			Handle var = to_visit.back();
+			to_visit.pop_back();
+			if (not reached.insert(var).second)
+				continue;
+			auto vgit = vg.find(var);
+			if (vgit != vg.end())
+				to_visit.insert(to_visit.end(),
+				                vgit->second.begin(), vgit->second.end());
 		}
 	}
-	return nvg;
+	return cvg;
 }
 
 Handle Unify::substitute(BindLinkPtr bl, const TypedSubstitution& ts,
@@ -568,7 +597,7 @@ Handle Unify::remove_constant_clauses(const Handle& vardecl,
 	return createLink(std::move(hs), AND_LINK);
 }
 
-Unify::SolutionSet Unify::operator()()
+Unify::SolutionSet Unify::operator()() const
 {
 	// If the declaration is ill typed, there is no solution
 	if (not _variables.is_well_typed())
@@ -681,77 +710,121 @@ Unify::SolutionSet Unify::unordered_unify(const HandleSeq& lhs,
 Unify::SolutionSet Unify::ordered_unify(const HandleSeq& lhs,
                                         const HandleSeq& rhs,
                                         Context lc, Context rc) const
+{
+	return ordered_unify(lhs, 0, rhs, 0, lc, rc);
+}
+
+Unify::SolutionSet Unify::ordered_unify(const HandleSeq& lhs, size_t lb,
+                                        const HandleSeq& rhs, size_t rb,
+                                        Context lc, Context rc) const
 {
 	SolutionSet sol(false);
 
-	if (lhs.empty() and rhs.empty()) return SolutionSet(true);
+	bool l_empty = lhs.size() <= lb;
+	bool r_empty = rhs.size() <= rb;
+	if (l_empty and r_empty) return SolutionSet(true);
 
-#define is_lh_glob lhs[0]->get_type() == GLOB_NODE and is_declared_variable(lhs[0])
-#define is_rh_glob rhs[0]->get_type() == GLOB_NODE and is_declared_variable(rhs[0])
+	bool l_glob = not l_empty and is_glob(lhs[lb]);
+	bool r_glob = not r_empty and is_glob(rhs[rb]);
 
-	if (!lhs.empty() and !rhs.empty() and !(is_lh_glob) and !(is_rh_glob)){
-		const auto head_sol = unify(lhs[0], rhs[0], lc, rc);
-		const auto tail_sol = ordered_unify(tail(lhs), tail(rhs), lc, rc);
+	if (not l_empty and not r_empty and not l_glob and not r_glob) {
+		const auto head_sol = unify(lhs[lb], rhs[rb], lc, rc);
+		// No need to unify the tails if the heads do not unify
+		if (not head_sol.is_satisfiable())
+			return head_sol;
+		const auto tail_sol = ordered_unify(lhs, lb + 1, rhs, rb + 1, lc, rc);
 		return join(head_sol, tail_sol);
 	}
 
-	// If lhs[0] we need to try to unify for every possible number
-	// of arguments the glob can contain.
-	if (!lhs.empty() and is_lh_glob)
-		ordered_unify_glob(lhs, rhs, sol, lc, rc);
+	// If lhs[lb] is a glob we need to try to unify for every possible
+	// number of arguments the glob can contain.
+	if (l_glob)
+		ordered_unify_glob(lhs, lb, rhs, rb, sol, lc, rc);
 
 	// The flip flag is to prevent redundant partitions.
 	// i:e for globs X and U with the same type restriction
 	//     {{{X, U}, U}} and {{{X, U}, X}} are equivalent.
-	if (!rhs.empty() and is_rh_glob)
-		ordered_unify_glob(rhs, lhs, sol, rc, lc, true);
-
-#undef is_lh_glob
-#undef is_rh_glob
+	if (r_glob)
+		ordered_unify_glob(rhs, rb, lhs, lb, sol, rc, lc, true);
 
 	return sol;
 }
 
-void Unify::ordered_unify_glob(const HandleSeq &lhs,
-                               const HandleSeq &rhs,
-                               Unify::SolutionSet &sol,
+void Unify::ordered_unify_glob(const HandleSeq& lhs, size_t lb,
+                               const HandleSeq& rhs, size_t rb,
+                               Unify::SolutionSet& sol,
                                Context lc, Context rc, bool flip) const
 {
-	const auto inter = _variables.get_interval(lhs[0]);
-	for (size_t i = inter.first;
-	     (i <= inter.second and i <= rhs.size()); i++) {
+	const GlobInterval& inter = _variables.get_interval(lhs[lb]);
+	const size_t rsize = rhs.size() - rb;
+
+	// Interval of the number of elements the glob can pick. If the
+	// rest of rhs has no glob, then the rest of lhs must be able to
+	// unify with exactly what the glob leaves.
+	double lo = inter.first;
+	double hi = std::min(inter.second, (double)rsize);
+	if (not has_glob(rhs, rb)) {
+		GlobInterval tail_inter = arity_interval(lhs, lb + 1);
+		lo = std::max(lo, rsize - tail_inter.second);
+		hi = std::min(hi, rsize - tail_inter.first);
+	}
+
+	for (double d = lo; d <= hi; d++) {
+		size_t i = d;
 		// The condition is to avoid extra complexity when calculating
 		// type-intersection for glob. Should be fixed from the atomspace
 		// Variables::is_type.
 		Handle r_h;
 		if (i == 1) {
-			Type rtype = (*rhs.begin())->get_type();
+			Type rtype = rhs[rb]->get_type();
 			if (GLOB_NODE == rtype)
-				r_h = *rhs.begin();
+				r_h = rhs[rb];
 			else if (QUOTE_LINK == rtype or UNQUOTE_LINK == rtype)
-				r_h = createLink((*rhs.begin())->getOutgoingSet(), LIST_LINK);
-			else r_h = createLink(HandleSeq(rhs.begin(), rhs.begin() + i), LIST_LINK);
+				r_h = createLink(rhs[rb]->getOutgoingSet(), LIST_LINK);
+			else r_h = createLink(HandleSeq(1, rhs[rb]), LIST_LINK);
 		}
-		else r_h = createLink(HandleSeq(rhs.begin(), rhs.begin() + i), LIST_LINK);
+		else r_h = createLink(HandleSeq(rhs.begin() + rb, rhs.begin() + rb + i),
+		                      LIST_LINK);
 
 		auto head_sol = flip ?
-		                unify(r_h, lhs[0], rc, lc) :
-		                unify(lhs[0], r_h, lc, rc);
+		                unify(r_h, lhs[lb], rc, lc) :
+		                unify(lhs[lb], r_h, lc, rc);
+		if (not head_sol.is_satisfiable())
+			continue;
 		auto tail_sol = flip ?
-		                ordered_unify(tail(rhs, i), tail(lhs), rc, lc) :
-		                ordered_unify(tail(lhs), tail(rhs, i), lc, rc);
+		                ordered_unify(rhs, rb + i, lhs, lb + 1, rc, lc) :
+		                ordered_unify(lhs, lb + 1, rhs, rb + i, lc, rc);
 		sol.insert(join(tail_sol, head_sol));
 	}
 }
 
-HandleSeq Unify::tail(const HandleSeq &seq) const
+bool Unify::is_glob(const Handle& h) const
 {
-	return seq.empty() ? seq : HandleSeq(std::next(seq.begin()), seq.end());
+	return h->get_type() == GLOB_NODE and is_declared_variable(h);
 }
 
-HandleSeq Unify::tail(const HandleSeq &seq, const size_t offset) const
+bool Unify::has_glob(const HandleSeq& seq, size_t b) const
 {
-	return seq.size() < offset ? seq : HandleSeq(seq.begin() + offset, seq.end());
+	for (size_t i = b; i < seq.size(); i++)
+		if (is_glob(seq[i]))
+			return true;
+	return false;
+}
+
+GlobInterval Unify::arity_interval(const HandleSeq& seq, size_t b) const
+{
+	GlobInterval inter(0, 0);
+	for (size_t i = b; i < seq.size(); i++) {
+		if (is_glob(seq[i])) {
+			const GlobInterval& gi = _variables.get_interval(seq[i]);
+			inter.first += gi.first;
+			inter.second += gi.second;
+		} else {
+			inter.first++;
+			inter.second++;
+		}
+	}
+	return inter;
 }
 
 Unify::SolutionSet Unify::pairwise_unify(const std::set<CHandlePair>& pchs) const
@@ -1003,10 +1076,85 @@ bool Unify::is_satisfiable(const TypedBlock& block) const
 bool unifiable(const Handle& lhs, const Handle& rhs,
                const Handle& lhs_vardecl, const Handle& rhs_vardecl)
 {
+	if (not structurally_unifiable(lhs, rhs))
+		return false;
+
 	Unify unify(lhs, rhs, lhs_vardecl, rhs_vardecl);
 	return unify().is_satisfiable();
 }
 
+static bool is_wildcard(Type t)
+{
+	return t == VARIABLE_NODE or t == GLOB_NODE;
+}
+
+static bool is_quotation(Type t)
+{
+	return t == QUOTE_LINK or t == UNQUOTE_LINK or t == LOCAL_QUOTE_LINK;
+}
+
+static bool structurally_unifiable(const HandleSeq& lhs, const HandleSeq& rhs)
+{
+	auto is_glob = [](const Handle& h) { return h->get_type() == GLOB_NODE; };
+	size_t ls = lhs.size(), rs = rhs.size();
+
+	// Compare the prefixes up to the first glob
+	size_t b = 0;
+	for (; b < ls and b < rs and not is_glob(lhs[b]) and not is_glob(rhs[b]); b++)
+		if (not structurally_unifiable(lhs[b], rhs[b]))
+			return false;
+
+	// Compare the suffixes from the last glob. Since a non-glob
+	// consumes exactly one element, the last elements of both sides
+	// are unified together unless one of them is a glob.
+	size_t e = 0;
+	for (; b + e < ls and b + e < rs
+		     and not is_glob(lhs[ls - 1 - e]) and not is_glob(rhs[rs - 1 - e]); e++)
+		if (not structurally_unifiable(lhs[ls - 1 - e], rhs[rs - 1 - e]))
+			return false;
+
+	// The remaining elements must have the same size, or be absorbed
+	// by some glob
+	return ls == rs
+		or std::any_of(lhs.begin() + b, lhs.end() - e, is_glob)
+		or std::any_of(rhs.begin() + b, rhs.end() - e, is_glob);
+}
+
+bool structurally_unifiable(const Handle& lhs, const Handle& rhs)
+{
+	if (lhs == rhs)
+		return true;
+
+	// Skip quotations, they only affect whether variables are free,
+	// and variables are treated as wildcards anyway.
+	Handle lh(lhs), rh(rhs);
+	while (is_quotation(lh->get_type()))
+		lh = lh->getOutgoingAtom(0);
+	while (is_quotation(rh->get_type()))
+		rh = rh->getOutgoingAtom(0);
+
+	Type lt = lh->get_type();
+	Type rt = rh->get_type();
+	if (is_wildcard(lt) or is_wildcard(rt))
+		return true;
+	if (lt != rt)
+		return false;
+	if (lh->is_node())
+		return lh->get_hash() == rh->get_hash() and content_eq(lh, rh);
+
+	// Permutations are not considered, only compare arities, unless
+	// some glob can absorb the difference.
+	const HandleSeq& loset = lh->getOutgoingSet();
+	const HandleSeq& roset = rh->getOutgoingSet();
+	if (lh->is_unordered_link()) {
+		auto is_glob = [](const Handle& h) { return h->get_type() == GLOB_NODE; };
+		return loset.size() == roset.size()
+			or std::any_of(loset.begin(), loset.end(), is_glob)
+			or std::any_of(roset.begin(), roset.end(), is_glob);
+	}
+	return structurally_unifiable(loset, roset);
+}
+
 bool hm_content_eq(const HandleMap& lhs, const HandleMap& rhs)
 {
 	if (lhs.size() != rhs.size())
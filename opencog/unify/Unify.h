@@ -38,6 +38,19 @@
 
 namespace opencog {
 
+/**
+ * Unifier of two terms.
+ *
+ * Thread safety: a Unify object is immutable once constructed, all
+ * its methods are const and only use local state, so the same object
+ * can be used from several threads at once, and so can different
+ * objects. Its static methods, as well as the free functions below,
+ * are reentrant as well. The only shared state are the constant
+ * solution sets empty_partitions and empty_partition_singleton.
+ * Unifying from several threads is thus safe, but does not scale any
+ * better than the global allocator, as no per-thread allocation
+ * arena is used.
+ */
 class Unify
 {
 	friend class UnifyUTest;
@@ -132,6 +145,11 @@ public:
 	// Partition block. A block is a set of CHandles that are
 	// hypothesized as being unifiable, that is there exists a
 	// substitution making them equal.
+	//
+	// Blocks, partitions and solution sets use the default
+	// allocator. An arena scoped to a unification call cannot be
+	// used, as the partitions outlive it in the returned solution
+	// set and in the typed substitutions built from it.
 	typedef std::set<CHandle> Block;
 
 	// Mapping from partition blocks to type. The type for now is the
@@ -308,20 +326,16 @@ public:
 	/**
 	 * Same above but uses a graph obtained from vargraph.
 	 *
-	 * Note: argument is passed by copy for implementational convenience.
+	 * Linear in the size of the graph.
 	 */
 	static bool has_cycle(const HandleMultimap& vg);
 
 	/**
-	 * Return the closure of vg.
+	 * Return the closure of vg, that is map each variable to all
+	 * variables reachable from it.
 	 */
 	static HandleMultimap closure(const HandleMultimap& vg);
 
-	/**
-	 * Return one step of closure of vg.
-	 */
-	static HandleMultimap closure_step(const HandleMultimap& vg);
-
 	/**
 	 * Given a typed substitution, perform the substitution over a scope
 	 * link (for now only BindLinks are supported).
@@ -507,26 +521,23 @@ public:
 	 * A and Y unifies to B, and another one where X unifies to B and Y
 	 * unifies to A.
 	 */
-	SolutionSet operator()();
+	SolutionSet operator()() const;
 
 private:
-	// Terms to unify
-	Handle _lhs;
-	Handle _rhs;
+	// Terms to unify, and their common variable declaration. Set
+	// once and for all at construction.
+	const Handle _lhs;
+	const Handle _rhs;
+	const Variables _variables;
 
-	// Common variable declaration of the two terms to unify.
-	Variables _variables;
-
-public:                         // ???? It's a friend yet
 	/**
-	 * Set Unify::_variables given the variable declarations of the
-	 * two terms to unify.
+	 * Return the common variable declaration of the two terms to
+	 * unify, given their variable declarations.
 	 */
-	void set_variables(const Handle& lhs, const Handle& rhs,
-	                   const Handle& lhs_vardecl=Handle::UNDEFINED,
-	                   const Handle& rhs_vardecl=Handle::UNDEFINED);
+	static Variables gen_variables(const Handle& lhs, const Handle& rhs,
+	                               const Handle& lhs_vardecl,
+	                               const Handle& rhs_vardecl);
 
-private:
 	/**
 	 * Find the least abstract atom in the given block.
 	 */
@@ -566,6 +577,14 @@ private:
 	                          Context lhs_context=Context(),
 	                          Context rhs_context=Context()) const;
 
+	/**
+	 * Like above but only unify lhs from index lb with rhs from index
+	 * rb, to avoid copying tails.
+	 */
+	SolutionSet ordered_unify(const HandleSeq& lhs, size_t lb,
+	                          const HandleSeq& rhs, size_t rb,
+	                          Context lhs_context, Context rhs_context) const;
+
 	/**
 	 * Unify all pairs of CHandles.
 	 */
@@ -799,29 +818,25 @@ private:
 	bool is_node_satisfiable(const CHandle& lch, const CHandle& rch) const;
 
 	/**
-	 * Return the attractive fixpoint of a unary function and its
-	 * argument, if it exists.  If no attractive fixpoint exists then it
-	 * may never return.
-	 *
-	 * For the definition of fixpoint see
-	 *
-	 * https://en.wikipedia.org/wiki/Fixed_point_(mathematics)
+	 * Return true iff h is a declared glob.
 	 */
-	template<typename F, typename A>
-	static A fixpoint(const F& fun, const A& arg)
-	{
-		A res = fun(arg);
-		if (res == arg)
-			return res;
-		return fixpoint(fun, res);
-	}
+	bool is_glob(const Handle& h) const;
 
-	HandleSeq tail(const HandleSeq &seq) const;
+	/**
+	 * Return true iff seq has a declared glob from index b.
+	 */
+	bool has_glob(const HandleSeq& seq, size_t b) const;
 
-	HandleSeq tail(const HandleSeq &seq, const size_t offset) const;
+	/**
+	 * Return the interval of the number of elements that seq from
+	 * index b can be unified with, 1 for each non-glob element, and
+	 * the interval of each declared glob.
+	 */
+	GlobInterval arity_interval(const HandleSeq& seq, size_t b) const;
 
 	/**
-	 * Unify lhs and rhs where at least lhs contains a glob.
+	 * Unify lhs from index lb and rhs from index rb, where lhs[lb] is
+	 * a glob.
 	 *
 	 * For every possible allowed interval of the glob in lhs
 	 * three operations will be undergone:
@@ -831,17 +846,24 @@ private:
 	 *             2 is the first allowed interval for X
 	 *             head_sol = unify(X, AB) = {{X, List(A, B)}, List(A, B)}
 	 *
-	 * 2/ remove glob from lhs and unified atoms from rhs. Then recurse over
+	 * 2/ skip glob in lhs and unified atoms in rhs. Then recurse over
 	 *    the the remaining as tail_sol.
 	 *    Example: ordered_unify(Y[0, inf], C)
 	 *
 	 * 3/ join the head_sol and tail_sol into a complite solution and insert
 	 *    it tosolutions.
-	 */
-	void ordered_unify_glob(const HandleSeq &lhs, const HandleSeq &rhs,
-	                        SolutionSet &sol,
-	                        Context lhs_context=Context(),
-	                        Context rhs_context=Context(),
+	 *
+	 * If the rest of rhs has no glob, then its size is fixed, and the
+	 * number of elements picked by the glob is restricted so that the
+	 * rest of lhs, according to its arity interval, can unify with
+	 * what remains of rhs.
+	 *    Example: lhs = X[0, inf]AB, rhs = ABCAB
+	 *             X can only pick 3 elements.
+	 */
+	void ordered_unify_glob(const HandleSeq& lhs, size_t lb,
+	                        const HandleSeq& rhs, size_t rb,
+	                        SolutionSet& sol,
+	                        Context lhs_context, Context rhs_context,
 	                        bool flip=false) const;
 };
 
@@ -849,6 +871,22 @@ bool unifiable(const Handle& lhs, const Handle& rhs,
                const Handle& lhs_vardecl=Handle::UNDEFINED,
                const Handle& rhs_vardecl=Handle::UNDEFINED);
 
+/**
+ * Cheap, allocation free, necessary condition for lhs and rhs to be
+ * unifiable. Return false if they certainly are not, that is if they
+ * differ in type, arity or constant node somewhere in their common
+ * skeleton, true otherwise.
+ *
+ * Variables and globs are treated as wildcards, regardless of their
+ * declarations, and quotation links are skipped, so that this never
+ * rules out terms that Unify would unify. The outgoings of unordered
+ * links are not compared.
+ *
+ * Meant to be called before building a Unify object, as most
+ * unification attempts fail.
+ */
+bool structurally_unifiable(const Handle& lhs, const Handle& rhs);
+
 /**
  * Till content equality between atoms become the default.
  */
@@ -0,0 +1,197 @@
+/**
+ * UnifyCache.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ * Author: agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "UnifyCache.h"
+
+#include <sstream>
+
+#include <boost/functional/hash.hpp>
+
+namespace opencog {
+
+UnifyCache::UnifyCache(size_t max_size)
+	: _max_size(max_size), _hits(0), _misses(0) {}
+
+Unify::TypedSubstitutions
+UnifyCache::typed_substitutions(const Handle& lhs, const Handle& rhs,
+                                const Handle& lhs_vardecl,
+                                const Handle& rhs_vardecl)
+{
+	Key key{lhs, rhs, lhs_vardecl, rhs_vardecl};
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (0 < _max_size) {
+			auto it = _index.find(key);
+			if (it != _index.end()) {
+				_hits++;
+				// Move it to the front, as the most recently used
+				_entries.splice(_entries.begin(), _entries, it->second);
+				return it->second->second;
+			}
+			_misses++;
+		}
+	}
+
+	// Unify outside of the lock, as it is the costly part
+	Unify::TypedSubstitutions tss =
+		typed_substitutions(nullptr, lhs, rhs, lhs_vardecl, rhs_vardecl);
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	// It may have been inserted in the meantime by another thread
+	if (0 < _max_size and _index.find(key) == _index.end()) {
+		_entries.emplace_front(key, tss);
+		_index[key] = _entries.begin();
+		shrink();
+	}
+	return tss;
+}
+
+Unify::TypedSubstitutions
+UnifyCache::typed_substitutions(UnifyCache* cache,
+                                const Handle& lhs, const Handle& rhs,
+                                const Handle& lhs_vardecl,
+                                const Handle& rhs_vardecl)
+{
+	if (cache)
+		return cache->typed_substitutions(lhs, rhs, lhs_vardecl, rhs_vardecl);
+
+	Unify unify(lhs, rhs, lhs_vardecl, rhs_vardecl);
+	Unify::SolutionSet sol = unify();
+	if (not sol.is_satisfiable())
+		return {};
+	return unify.typed_substitutions(sol, lhs);
+}
+
+void UnifyCache::set_max_size(size_t max_size)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_max_size = max_size;
+	shrink();
+}
+
+size_t UnifyCache::get_max_size() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _max_size;
+}
+
+size_t UnifyCache::size() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _entries.size();
+}
+
+size_t UnifyCache::get_hits() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _hits;
+}
+
+size_t UnifyCache::get_misses() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _misses;
+}
+
+void UnifyCache::clear()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_index.clear();
+	_entries.clear();
+	_hits = 0;
+	_misses = 0;
+}
+
+std::string UnifyCache::to_string(const std::string& indent) const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	std::stringstream ss;
+	ss << indent << "size = " << _entries.size()
+	   << ", max_size = " << _max_size
+	   << ", hits = " << _hits
+	   << ", misses = " << _misses;
+	return ss.str();
+}
+
+void UnifyCache::shrink()
+{
+	while (_max_size < _entries.size()) {
+		_index.erase(_entries.back().first);
+		_entries.pop_back();
+	}
+}
+
+size_t UnifyCache::KeyHash::operator()(const Key& key) const
+{
+	size_t seed = 0;
+	for (const Handle& h : {key.lhs, key.rhs, key.lhs_vardecl, key.rhs_vardecl})
+		boost::hash_combine(seed, structural_hash(h));
+	return seed;
+}
+
+bool UnifyCache::KeyEqual::operator()(const Key& lhs, const Key& rhs) const
+{
+	return structural_eq(lhs.lhs, rhs.lhs)
+		and structural_eq(lhs.rhs, rhs.rhs)
+		and structural_eq(lhs.lhs_vardecl, rhs.lhs_vardecl)
+		and structural_eq(lhs.rhs_vardecl, rhs.rhs_vardecl);
+}
+
+size_t UnifyCache::structural_hash(const Handle& h)
+{
+	if (not h)
+		return 0;
+	size_t seed = h->get_type();
+	if (h->is_node())
+		boost::hash_combine(seed, h->get_name());
+	else
+		for (const Handle& child : h->getOutgoingSet())
+			boost::hash_combine(seed, structural_hash(child));
+	return seed;
+}
+
+bool UnifyCache::structural_eq(const Handle& lhs, const Handle& rhs)
+{
+	if (lhs == rhs)
+		return true;
+	if (not lhs or not rhs or lhs->get_type() != rhs->get_type())
+		return false;
+	if (lhs->is_node())
+		return lhs->get_name() == rhs->get_name();
+
+	const HandleSeq& lhs_oset = lhs->getOutgoingSet();
+	const HandleSeq& rhs_oset = rhs->getOutgoingSet();
+	if (lhs_oset.size() != rhs_oset.size())
+		return false;
+	for (size_t i = 0; i < lhs_oset.size(); i++)
+		if (not structural_eq(lhs_oset[i], rhs_oset[i]))
+			return false;
+	return true;
+}
+
+std::string oc_to_string(const UnifyCache& uc, const std::string& indent)
+{
+	return uc.to_string(indent);
+}
+
+} // namespace opencog
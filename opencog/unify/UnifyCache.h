@@ -0,0 +1,155 @@
+/**
+ * UnifyCache.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ * All Rights Reserved
+ * Author: agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_UNIFY_CACHE_H
+#define _OPENCOG_UNIFY_CACHE_H
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "Unify.h"
+
+namespace opencog {
+
+/**
+ * Size-bounded, least recently used, cache of unification results.
+ *
+ * Results are keyed by the structure of the terms to unify and their
+ * variable declarations, so that the same pairs unified across
+ * iterations are only unified once. Each chainer owns its cache, so
+ * that cached atoms are released with it, and its hits and misses
+ * are its own.
+ * Keys are compared atom by atom, thus pairs that differ only by
+ * variable names, including the ones of scope links, are different
+ * keys, as the cached substitutions refer to these variables.
+ *
+ * The cache is disabled (of size 0) by default.
+ */
+class UnifyCache
+{
+public:
+	UnifyCache(size_t max_size=0);
+
+	/**
+	 * Return the typed substitutions of the unification of lhs and
+	 * rhs, selecting values in lhs when multiple choices are
+	 * possible, see Unify::typed_substitutions. Return an empty set
+	 * if they are not unifiable.
+	 *
+	 * Look them up first, and if missing calculate and insert them.
+	 */
+	Unify::TypedSubstitutions
+	typed_substitutions(const Handle& lhs, const Handle& rhs,
+	                    const Handle& lhs_vardecl=Handle::UNDEFINED,
+	                    const Handle& rhs_vardecl=Handle::UNDEFINED);
+
+	/**
+	 * Like above but without any cache, if cache is null, or using
+	 * cache otherwise.
+	 */
+	static Unify::TypedSubstitutions
+	typed_substitutions(UnifyCache* cache,
+	                    const Handle& lhs, const Handle& rhs,
+	                    const Handle& lhs_vardecl=Handle::UNDEFINED,
+	                    const Handle& rhs_vardecl=Handle::UNDEFINED);
+
+	/**
+	 * Set the maximum number of cached results, discarding the least
+	 * recently used ones beyond it. 0 disables the cache.
+	 */
+	void set_max_size(size_t max_size);
+	size_t get_max_size() const;
+
+	/**
+	 * Number of cached results.
+	 */
+	size_t size() const;
+
+	/**
+	 * Number of lookups that have been, or have not been, found in
+	 * the cache since its creation or the last reset.
+	 */
+	size_t get_hits() const;
+	size_t get_misses() const;
+
+	/**
+	 * Remove all cached results, and reset the counters.
+	 */
+	void clear();
+
+	std::string to_string(const std::string& indent=empty_string) const;
+
+private:
+	struct Key
+	{
+		Handle lhs;
+		Handle rhs;
+		Handle lhs_vardecl;
+		Handle rhs_vardecl;
+	};
+
+	struct KeyHash
+	{
+		size_t operator()(const Key& key) const;
+	};
+
+	struct KeyEqual
+	{
+		bool operator()(const Key& lhs, const Key& rhs) const;
+	};
+
+	// Hash and equality of atoms by their structure, that is their
+	// types, names and outgoings, unlike get_hash and content_eq
+	// which are invariant under alpha-conversion of scope links.
+	static size_t structural_hash(const Handle& h);
+	static bool structural_eq(const Handle& lhs, const Handle& rhs);
+
+	typedef std::pair<Key, Unify::TypedSubstitutions> Entry;
+	typedef std::list<Entry> Entries;
+
+	// Entries from most to least recently used, and their index
+	Entries _entries;
+	std::unordered_map<Key, Entries::iterator, KeyHash, KeyEqual> _index;
+
+	size_t _max_size;
+	size_t _hits;
+	size_t _misses;
+
+	mutable std::mutex _mutex;
+
+	// Discard least recently used entries beyond _max_size
+	void shrink();
+};
+
+// Debugging helpers see
+// http://wiki.opencog.org/w/Development_standards#Print_OpenCog_Objects
+// The reason indent is not an optional argument with default is
+// because gdb doesn't support that, see
+// http://stackoverflow.com/questions/16734783 for more explanation.
+std::string oc_to_string(const UnifyCache& uc,
+                         const std::string& indent=empty_string);
+
+} // namespace opencog
+
+#endif // _OPENCOG_UNIFY_CACHE_H
@@ -48,6 +48,13 @@ HandleCounter ActionSelection::distribution()
 	return action2prob;
 }
 
+Handle ActionSelection::operator()(SelectionPolicy policy,
+                                   unsigned tournament_size)
+{
+	size_t idx = PolicySelection(_tvs, policy, tournament_size)();
+	return std::next(action2tv.begin(), idx)->first;
+}
+
 std::string ActionSelection::to_string(const std::string& indent) const
 {
 	std::stringstream ss;
@@ -28,6 +28,7 @@
 #include <opencog/atoms/truthvalue/TruthValue.h>
 
 #include "ThompsonSampling.h"
+#include "SelectionPolicy.h"
 
 namespace opencog
 {
@@ -69,10 +70,12 @@ public:
 	HandleCounter distribution();
 
 	/**
-	 * Perform random action selection according to the action
-	 * distribution.
+	 * Select an action according to the given policy, without
+	 * building the action distribution (Thompson is thus treated as
+	 * SingleDrawThompson).
 	 */
-	Handle operator()();
+	Handle operator()(SelectionPolicy policy=SelectionPolicy::SingleDrawThompson,
+	                  unsigned tournament_size=2);
 
 	std::string to_string(const std::string& indent=empty_string) const;
 
@@ -0,0 +1,177 @@
+/*
+ * ActionStatistics.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * Author: agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "ActionStatistics.h"
+
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#include <opencog/util/exceptions.h>
+#include <opencog/atoms/truthvalue/SimpleTruthValue.h>
+
+#include "URELogger.h"
+
+namespace opencog {
+
+void ActionStatistics::add_trial(const Handle& action)
+{
+	_counts[action].count += 1.0;
+}
+
+void ActionStatistics::add_success(const Handle& action)
+{
+	_counts[action].pos_count += 1.0;
+}
+
+ActionStatistics::Counts ActionStatistics::get_counts(const Handle& action) const
+{
+	auto it = _counts.find(action);
+	return it == _counts.end() ? Counts() : it->second;
+}
+
+TruthValuePtr ActionStatistics::tv(const Handle& action,
+                                   const TruthValuePtr& prior_tv) const
+{
+	Counts cnts = get_counts(action);
+	if (cnts.count <= 0.0)
+		return prior_tv;
+
+	// A prior of confidence 1 has an infinite count, no finite
+	// number of trials can change it.
+	double prior_count = prior_tv->get_count();
+	if (std::isinf(prior_count))
+		return prior_tv;
+
+	double pos_count = prior_tv->get_mean() * prior_count + cnts.pos_count,
+		count = prior_count + cnts.count,
+		strength = pos_count / count,
+		confidence = count / (count + SimpleTruthValue::DEFAULT_K);
+	return SimpleTruthValue::createTV(strength, confidence);
+}
+
+HandleTVMap ActionStatistics::tvs(const HandleTVMap& prior_tvs) const
+{
+	HandleTVMap results;
+	for (const auto& atv : prior_tvs)
+		results[atv.first] = tv(atv.first, atv.second);
+	return results;
+}
+
+size_t ActionStatistics::size() const
+{
+	return _counts.size();
+}
+
+bool ActionStatistics::empty() const
+{
+	return _counts.empty();
+}
+
+void ActionStatistics::clear()
+{
+	_counts.clear();
+}
+
+void ActionStatistics::save(const std::string& filename) const
+{
+	std::ofstream ofs(filename);
+	if (not ofs)
+		throw RuntimeException(TRACE_INFO,
+		                       "ActionStatistics::save - cannot open %s",
+		                       filename.c_str());
+
+	// So that loading restores the counts exactly
+	ofs << std::setprecision(std::numeric_limits<double>::max_digits10);
+	for (const auto& ac : _counts) {
+		if (not ac.first->is_node()) {
+			ure_logger().warn() << "ActionStatistics::save - ignore "
+			                    << "non node action "
+			                    << ac.first->to_short_string();
+			continue;
+		}
+		ofs << ac.second.pos_count << " " << ac.second.count << " "
+		    << nameserver().getTypeName(ac.first->get_type()) << " "
+		    << ac.first->get_name() << std::endl;
+	}
+}
+
+void ActionStatistics::load(const std::string& filename, AtomSpace& as)
+{
+	std::ifstream ifs(filename);
+	if (not ifs)
+		throw RuntimeException(TRACE_INFO,
+		                       "ActionStatistics::load - cannot open %s",
+		                       filename.c_str());
+
+	std::string line;
+	while (std::getline(ifs, line)) {
+		if (line.empty())
+			continue;
+
+		// Parse <pos_count> <count> <type> <name>, the name being the
+		// remainder of the line, as it may contain spaces.
+		std::istringstream iss(line);
+		Counts cnts;
+		std::string type_name, name;
+		if (not (iss >> cnts.pos_count >> cnts.count >> type_name)
+		    or iss.get() != ' ' or not std::getline(iss, name))
+			throw RuntimeException(TRACE_INFO,
+			                       "ActionStatistics::load - ill-formed line "
+			                       "in %s: %s", filename.c_str(), line.c_str());
+		Type type = nameserver().getType(type_name);
+		if (type == NOTYPE)
+			throw RuntimeException(TRACE_INFO,
+			                       "ActionStatistics::load - unknown type %s",
+			                       type_name.c_str());
+
+		Counts& acnts = _counts[as.add_node(type, std::move(name))];
+		acnts.pos_count += cnts.pos_count;
+		acnts.count += cnts.count;
+	}
+}
+
+std::string ActionStatistics::to_string(const std::string& indent) const
+{
+	std::stringstream ss;
+	ss << indent << "size = " << _counts.size() << std::endl;
+	int i = 0;
+	for (const auto& ac : _counts) {
+		ss << indent << "action[" << i << "]:" << std::endl
+		   << oc_to_string(ac.first, indent + OC_TO_STRING_INDENT)
+		   << indent << "counts[" << i << "]: pos_count = "
+		   << ac.second.pos_count << ", count = " << ac.second.count
+		   << std::endl;
+		i++;
+	}
+	return ss.str();
+}
+
+std::string oc_to_string(const ActionStatistics& astat, const std::string& indent)
+{
+	return astat.to_string(indent);
+}
+
+} // ~namespace opencog
@@ -0,0 +1,118 @@
+/*
+ * ActionStatistics.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * Author: agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#ifndef _OPENCOG_ACTIONSTATISTICS_H_
+#define _OPENCOG_ACTIONSTATISTICS_H_
+
+#include <opencog/util/empty_string.h>
+#include <opencog/atoms/base/Handle.h>
+#include <opencog/atoms/truthvalue/TruthValue.h>
+#include <opencog/atomspace/AtomSpace.h>
+
+#include "ActionSelection.h"
+
+namespace opencog
+{
+
+/**
+ * Online statistics of actions (such as inference rule aliases),
+ * counting how many times each action has been tried and how many
+ * times it has been successful. These counts can be turned into TVs
+ * to feed ActionSelection, and be saved to and loaded from a file so
+ * that a reasoning session can be warm started with the statistics
+ * gathered by previous ones.
+ */
+class ActionStatistics
+{
+public:
+	// Number of successes and number of trials of an action
+	struct Counts
+	{
+		double pos_count = 0.0;
+		double count = 0.0;
+	};
+
+	/**
+	 * Record that an action has been tried.
+	 */
+	void add_trial(const Handle& action);
+
+	/**
+	 * Record that a previously tried action has been successful.
+	 */
+	void add_success(const Handle& action);
+
+	/**
+	 * Return the counts of an action, zero if it has never been
+	 * tried.
+	 */
+	Counts get_counts(const Handle& action) const;
+
+	/**
+	 * Return the TV of an action, obtained by adding its counts to
+	 * the counts of prior_tv. If the action has never been tried, or
+	 * if prior_tv has a confidence of 1, thus an infinite count,
+	 * prior_tv is returned.
+	 */
+	TruthValuePtr tv(const Handle& action, const TruthValuePtr& prior_tv) const;
+
+	/**
+	 * Like above over a map from actions to their prior TVs.
+	 */
+	HandleTVMap tvs(const HandleTVMap& prior_tvs) const;
+
+	size_t size() const;
+	bool empty() const;
+	void clear();
+
+	/**
+	 * Save the statistics in a file, one line per action
+	 *
+	 * <pos_count> <count> <type> <name>
+	 *
+	 * Only node actions, such as rule aliases, are saved.
+	 */
+	void save(const std::string& filename) const;
+
+	/**
+	 * Load the statistics from a file generated by save, adding them
+	 * to the current ones. The action nodes are added to as.
+	 */
+	void load(const std::string& filename, AtomSpace& as);
+
+	std::string to_string(const std::string& indent=empty_string) const;
+
+private:
+	std::map<Handle, Counts> _counts;
+};
+
+// Debugging helpers see
+// http://wiki.opencog.org/w/Development_standards#Print_OpenCog_Objects
+// The reason indent is not an optional argument with default is
+// because gdb doesn't support that, see
+// http://stackoverflow.com/questions/16734783 for more explanation.
+std::string oc_to_string(const ActionStatistics& astat,
+                         const std::string& indent=empty_string);
+
+} // namespace opencog
+
+#endif /* _OPENCOG_ACTIONSTATISTICS_H_ */
@@ -63,6 +63,11 @@ double BetaDistribution::variance() const
 	return boost::math::variance(_beta_distribution);
 }
 
+double BetaDistribution::quantile(double p) const
+{
+	return boost::math::quantile(_beta_distribution, p);
+}
+
 std::vector<double> BetaDistribution::cdf(int bins) const
 {
 	std::vector<double> cdf;
@@ -74,6 +74,12 @@ public:
 	 */
 	double variance() const;
 
+	/**
+	 * Return the p-quantile of the distribution, that is x such that
+	 * cdf(x) = p.
+	 */
+	double quantile(double p) const;
+
 	/**
 	 * Generate a vector of the cdf of regularly spaced right-end
 	 * points, specifically
@@ -0,0 +1,138 @@
+/*
+ * ChainerStats.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * Author: agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "ChainerStats.h"
+
+#include <sstream>
+
+#include <opencog/atoms/value/FloatValue.h>
+#include <opencog/atoms/value/LinkValue.h>
+#include <opencog/atoms/value/StringValue.h>
+
+namespace opencog {
+
+const std::string ChainerStats::key_name = "URE:chainer-stats";
+
+// Must follow the order of ChainerStats::Counter
+static const std::string counter_names[ChainerStats::COUNTER_COUNT] = {
+	"unifications_attempted",
+	"unifications_succeeded",
+	"rule_applications",
+	"rule_products",
+	"sources_inserted",
+	"sources_rejected_duplicate",
+	"sources_tried",
+	"rules_tried",
+	"max_rules_per_source",
+	"andbits_created",
+	"andbits_rejected_cycle",
+	"andbits_rejected_duplicate",
+	"andbits_pruned",
+	"fcs_fulfillments",
+	"fcs_fulfillments_failed",
+	"fcs_results",
+	"unify_cache_hits",
+	"unify_cache_misses"
+};
+
+ChainerStats::ChainerStats()
+{
+	clear();
+}
+
+void ChainerStats::add(Counter counter, size_t n)
+{
+	_counters[counter] += n;
+}
+
+void ChainerStats::set(Counter counter, size_t n)
+{
+	_counters[counter] = n;
+}
+
+size_t ChainerStats::get(Counter counter) const
+{
+	return _counters[counter];
+}
+
+const std::string& ChainerStats::name(Counter counter)
+{
+	return counter_names[counter];
+}
+
+ChainerStats::Counts ChainerStats::get_counts() const
+{
+	Counts counts;
+	for (size_t i = 0; i < COUNTER_COUNT; i++)
+		counts.emplace_back(counter_names[i], _counters[i]);
+	return counts;
+}
+
+std::string ChainerStats::to_json() const
+{
+	std::stringstream ss;
+	ss << "{";
+	bool first = true;
+	for (const auto& nc : get_counts()) {
+		ss << (first ? "" : ", ") << "\"" << nc.first << "\": " << nc.second;
+		first = false;
+	}
+	ss << "}";
+	return ss.str();
+}
+
+ValuePtr ChainerStats::to_value() const
+{
+	std::vector<std::string> names;
+	std::vector<double> values;
+	for (const auto& nc : get_counts()) {
+		names.push_back(nc.first);
+		values.push_back(nc.second);
+	}
+	return createLinkValue(ValueSeq{createStringValue(names),
+	                                createFloatValue(values)});
+}
+
+void ChainerStats::clear()
+{
+	for (std::atomic<size_t>& counter : _counters)
+		counter = 0;
+}
+
+std::string ChainerStats::to_string(const std::string& indent) const
+{
+	std::stringstream ss;
+	bool first = true;
+	for (const auto& nc : get_counts()) {
+		ss << (first ? "" : "\n") << indent << nc.first << " = " << nc.second;
+		first = false;
+	}
+	return ss.str();
+}
+
+std::string oc_to_string(const ChainerStats& cs, const std::string& indent)
+{
+	return cs.to_string(indent);
+}
+
+} // ~namespace opencog
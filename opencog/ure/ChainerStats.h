@@ -0,0 +1,165 @@
+/*
+ * ChainerStats.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * Author: agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#ifndef _OPENCOG_CHAINERSTATS_H_
+#define _OPENCOG_CHAINERSTATS_H_
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <opencog/util/empty_string.h>
+#include <opencog/atoms/value/Value.h>
+
+namespace opencog
+{
+
+/**
+ * Counts of the events of an inference run, such as unifications,
+ * rule applications or and-BIT rejections, aggregated over the whole
+ * run and all its threads. They are meant to tune parameters such as
+ * the complexity penalty, the expansion pool size or the maximum BIT
+ * size on actual data.
+ *
+ * Some counters are specific to the forward chainer, others to the
+ * backward chainer, the remaining ones stay at zero.
+ */
+class ChainerStats
+{
+public:
+	enum Counter
+	{
+		// Unifications of a rule against a source (FC) or a BIT-node
+		// (BC), and how many of them produced at least one
+		// substitution.
+		UNIFICATIONS_ATTEMPTED,
+		UNIFICATIONS_SUCCEEDED,
+
+		// FC: rule applications and the number of atoms they have
+		// produced, including ones already produced before.
+		RULE_APPLICATIONS,
+		RULE_PRODUCTS,
+
+		// FC: products inserted as new sources, or rejected because
+		// they already were sources.
+		SOURCES_INSERTED,
+		SOURCES_REJECTED_DUPLICATE,
+
+		// FC: number of sources that have been tried with at least one
+		// rule, total and maximum number of rules tried per source.
+		// Calculated at the end of the run.
+		SOURCES_TRIED,
+		RULES_TRIED,
+		MAX_RULES_PER_SOURCE,
+
+		// BC: and-BITs created, including the initial one, and
+		// expansions rejected because they had a cycle, were already
+		// in the BIT (or the rule had already expanded the BIT-node),
+		// and and-BITs removed to keep the BIT under its maximum
+		// size.
+		ANDBITS_CREATED,
+		ANDBITS_REJECTED_CYCLE,
+		ANDBITS_REJECTED_DUPLICATE,
+		ANDBITS_PRUNED,
+
+		// BC: FCS fulfillments, how many of them have failed to run,
+		// and the number of results they have produced.
+		FCS_FULFILLMENTS,
+		FCS_FULFILLMENTS_FAILED,
+		FCS_RESULTS,
+
+		// Lookups of the unification cache of the chainer found, or
+		// not found, in it during the run.
+		UNIFY_CACHE_HITS,
+		UNIFY_CACHE_MISSES,
+
+		COUNTER_COUNT
+	};
+
+	typedef std::vector<std::pair<std::string, size_t>> Counts;
+
+	ChainerStats();
+
+	/**
+	 * Add n to, or set, a counter.
+	 */
+	void add(Counter counter, size_t n=1);
+	void set(Counter counter, size_t n);
+
+	/**
+	 * Return the value of a counter.
+	 */
+	size_t get(Counter counter) const;
+
+	/**
+	 * Return the name of a counter, such as "unifications_attempted".
+	 */
+	static const std::string& name(Counter counter);
+
+	/**
+	 * Return all counters, by name, in the order of their
+	 * declaration.
+	 */
+	Counts get_counts() const;
+
+	/**
+	 * Return the counters as a flat JSON object, such as
+	 *
+	 * {"unifications_attempted": 12, "unifications_succeeded": 4, ...}
+	 */
+	std::string to_json() const;
+
+	/**
+	 * Return the counters as a LinkValue of two values, their names
+	 * and their values, i.e.
+	 *
+	 * LinkValue
+	 *   StringValue <counter_1> ... <counter_n>
+	 *   FloatValue <value_1> ... <value_n>
+	 */
+	ValuePtr to_value() const;
+
+	void clear();
+
+	std::string to_string(const std::string& indent=empty_string) const;
+
+	// Name of the PredicateNode under which the counters of a run are
+	// attached to its rule base, when requested, see to_value.
+	static const std::string key_name;
+
+private:
+	std::array<std::atomic<size_t>, COUNTER_COUNT> _counters;
+};
+
+// Debugging helpers see
+// http://wiki.opencog.org/w/Development_standards#Print_OpenCog_Objects
+// The reason indent is not an optional argument with default is
+// because gdb doesn't support that, see
+// http://stackoverflow.com/questions/16734783 for more explanation.
+std::string oc_to_string(const ChainerStats& cs,
+                         const std::string& indent=empty_string);
+
+} // namespace opencog
+
+#endif /* _OPENCOG_CHAINERSTATS_H_ */
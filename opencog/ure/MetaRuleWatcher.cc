@@ -0,0 +1,128 @@
+/*
+ * MetaRuleWatcher.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * Author: agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "MetaRuleWatcher.h"
+
+#include <functional>
+
+#include <opencog/atoms/core/FindUtils.h>
+
+namespace opencog {
+
+MetaRuleWatcher::MetaRuleWatcher(AtomSpace& as) : _as(as)
+{
+	_add_connection = _as.atomAddedSignal().connect(
+		std::bind(&MetaRuleWatcher::on_atom_added, this,
+		          std::placeholders::_1));
+	_remove_connection = _as.atomRemovedSignal().connect(
+		std::bind(&MetaRuleWatcher::on_atom_removed, this,
+		          std::placeholders::_1));
+	_tv_connection = _as.TVChangedSignal().connect(
+		std::bind(&MetaRuleWatcher::on_tv_changed, this,
+		          std::placeholders::_1, std::placeholders::_2,
+		          std::placeholders::_3));
+}
+
+MetaRuleWatcher::~MetaRuleWatcher()
+{
+	_as.atomAddedSignal().disconnect(_add_connection);
+	_as.atomRemovedSignal().disconnect(_remove_connection);
+	_as.TVChangedSignal().disconnect(_tv_connection);
+}
+
+AtomSpace& MetaRuleWatcher::get_atomspace() const
+{
+	return _as;
+}
+
+bool MetaRuleWatcher::take_changed(const RulePtr& meta_rule)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto it = _watches.find(meta_rule);
+	if (it == _watches.end())
+		it = _watches.emplace(meta_rule, mk_watch(*meta_rule)).first;
+	bool changed = it->second.changed;
+	it->second.changed = false;
+	return changed;
+}
+
+MetaRuleWatcher::Watch MetaRuleWatcher::mk_watch(const Rule& meta_rule)
+{
+	Watch watch;
+	Handle implicant = meta_rule.get_implicant();
+	HandleSeq clauses = meta_rule.get_clauses();
+	if (not implicant or clauses.empty()) {
+		watch.any_type = true;
+		watch.tv_sensitive = true;
+		return watch;
+	}
+
+	watch.tv_sensitive =
+		contains_atomtype(implicant, GROUNDED_PREDICATE_NODE)
+		or contains_atomtype(implicant, GROUNDED_SCHEMA_NODE);
+
+	for (Handle clause : clauses) {
+		// Strip quotations to get the actual root type
+		while (clause->get_type() == QUOTE_LINK
+		       or clause->get_type() == LOCAL_QUOTE_LINK)
+			clause = clause->getOutgoingAtom(0);
+
+		Type t = clause->get_type();
+		if (t == VARIABLE_NODE or t == GLOB_NODE or t == UNQUOTE_LINK)
+			watch.any_type = true;
+		else
+			watch.types.insert(t);
+	}
+	return watch;
+}
+
+void MetaRuleWatcher::flag(Type t, bool tv_change)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	for (auto& rw : _watches) {
+		Watch& watch = rw.second;
+		if (watch.changed or (tv_change and not watch.tv_sensitive))
+			continue;
+		if (watch.any_type or watch.types.find(t) != watch.types.end())
+			watch.changed = true;
+	}
+}
+
+void MetaRuleWatcher::on_atom_added(const Handle& h)
+{
+	flag(h->get_type(), false);
+}
+
+void MetaRuleWatcher::on_atom_removed(const AtomPtr& atom)
+{
+	flag(atom->get_type(), false);
+}
+
+void MetaRuleWatcher::on_tv_changed(const Handle& h,
+                                    const TruthValuePtr& old_tv,
+                                    const TruthValuePtr& new_tv)
+{
+	flag(h->get_type(), true);
+}
+
+} // ~namespace opencog
@@ -0,0 +1,110 @@
+/*
+ * MetaRuleWatcher.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * Author: agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#ifndef _OPENCOG_METARULEWATCHER_H_
+#define _OPENCOG_METARULEWATCHER_H_
+
+#include <map>
+#include <mutex>
+#include <set>
+
+#include <opencog/atomspace/AtomSpace.h>
+
+#include "Rule.h"
+
+namespace opencog
+{
+
+/**
+ * Listen to the changes of an atomspace, so that a meta rule is only
+ * re-run over it if atoms it may match have been added or removed
+ * since its last run, or, if it has grounded predicates or schemata
+ * (that may look at TVs, such as true-enough), have had their TVs
+ * changed.
+ *
+ * The atoms a meta rule may match are the ones of the root types of
+ * its clauses, or all atoms if such a root is a variable. Checking
+ * an atom against them is cheap, thus steps over an unchanged
+ * atomspace pay nothing.
+ *
+ * The atomspace must outlive the watcher.
+ */
+class MetaRuleWatcher
+{
+public:
+	MetaRuleWatcher(AtomSpace& as);
+	~MetaRuleWatcher();
+
+	AtomSpace& get_atomspace() const;
+
+	/**
+	 * Return true iff meta_rule has never been passed to this
+	 * function, or if atoms it may match have changed since the last
+	 * time it was, then reset its flag.
+	 */
+	bool take_changed(const RulePtr& meta_rule);
+
+private:
+	// The atoms a meta rule may match, and whether they have changed
+	struct Watch
+	{
+		std::set<Type> types;
+		bool any_type = false;
+		bool tv_sensitive = false;
+		bool changed = true;
+	};
+
+	/**
+	 * Build the watch of a meta rule. If the atoms it may match
+	 * cannot be determined, it watches all atoms.
+	 */
+	static Watch mk_watch(const Rule& meta_rule);
+
+	/**
+	 * Flag the meta rules that may match an atom of type t, after
+	 * its addition or removal, or the change of its TV if
+	 * tv_change is true.
+	 */
+	void flag(Type t, bool tv_change);
+
+	void on_atom_added(const Handle& h);
+	void on_atom_removed(const AtomPtr& atom);
+	void on_tv_changed(const Handle& h, const TruthValuePtr& old_tv,
+	                   const TruthValuePtr& new_tv);
+
+	AtomSpace& _as;
+
+	// Watch of each meta rule passed to take_changed
+	std::map<RulePtr, Watch> _watches;
+
+	// Signal handlers may be called from any thread
+	std::mutex _mutex;
+
+	// Connections to the signals of the atomspace
+	int _add_connection;
+	int _remove_connection;
+	int _tv_connection;
+};
+
+} // namespace opencog
+
+#endif /* _OPENCOG_METARULEWATCHER_H_ */
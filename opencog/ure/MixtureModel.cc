@@ -35,6 +35,25 @@
 
 using namespace opencog;
 
+ModelSummary::ModelSummary(const Handle& model) :
+	length(get_all_uniq_atoms(model).size())
+{
+	set_tv(model->getTruthValue());
+}
+
+void ModelSummary::set_tv(const TruthValuePtr& mtv)
+{
+	if (tv == mtv)
+		return;
+
+	tv = mtv;
+	count = tv->get_count();
+	beta_factor = MixtureModel::beta_factor(tv);
+	BetaDistribution beta_dist(tv);
+	mean = beta_dist.mean();
+	variance = beta_dist.variance();
+}
+
 MixtureModel::MixtureModel(const HandleSet& mds, double cpx, double cmp) :
 	models(mds), cpx_penalty(cpx), compressiveness(cmp)
 {
@@ -47,16 +66,47 @@ TruthValuePtr MixtureModel::operator()() const
 	if (models.size() == 1)
 		return (*models.begin())->getTruthValue();
 
+	ModelSummarySeq summaries(models.begin(), models.end());
+	return mix(summaries.begin(), summaries.end(), cpx_penalty, compressiveness);
+}
+
+std::vector<TruthValuePtr> MixtureModel::mix(const ModelSummarySeq& summaries,
+                                             const std::vector<size_t>& offsets,
+                                             double cpx_penalty,
+                                             double compressiveness)
+{
+	std::vector<TruthValuePtr> tvs;
+	for (size_t i = 0; i + 1 < offsets.size(); i++)
+		tvs.push_back(mix(summaries.begin() + offsets[i],
+		                  summaries.begin() + offsets[i + 1],
+		                  cpx_penalty, compressiveness));
+	return tvs;
+}
+
+TruthValuePtr MixtureModel::mix(ModelSummarySeq::const_iterator begin,
+                                ModelSummarySeq::const_iterator end,
+                                double cpx_penalty, double compressiveness)
+{
+	// Don't bother mixing if there's only one TV
+	if (std::next(begin) == end)
+		return begin->tv;
+
+	// Mixture without models, only used to hold the parameters. The
+	// data set size is inferred from the summaries, see
+	// infer_data_set_size.
+	MixtureModel mm(HandleSet(), cpx_penalty, compressiveness);
+	for (auto it = begin; it != end; ++it)
+		mm.data_set_size = std::max(mm.data_set_size, it->count);
+
+	// Calculate the weights, that is prior_estimate * beta_factor
 	std::vector<TruthValuePtr> tvs;
 	std::vector<double> weights;
-	for (const Handle& model : models) {
-		double weight = prior_estimate(model) * beta_factor(model);
-		LAZY_URE_LOG_FINE << "MixtureModel::operator model = " << model->id_to_string()
-		                  << ", weight = " << weight;
-		tvs.push_back(model->getTruthValue());
-		weights.push_back(weight);
+	for (auto it = begin; it != end; ++it) {
+		tvs.push_back(it->tv);
+		weights.push_back(mm.prior_estimate(*it) * it->beta_factor);
 	}
-	return weighted_average(tvs, weights);
+
+	return mm.weighted_average(tvs, weights);
 }
 
 TruthValuePtr MixtureModel::weighted_average(const std::vector<TruthValuePtr>& tvs,
@@ -95,7 +145,12 @@ TruthValuePtr MixtureModel::weighted_average(const std::vector<TruthValuePtr>& t
 
 double MixtureModel::beta_factor(const Handle& model) const
 {
-	BetaDistribution beta_dist(model->getTruthValue());
+	return beta_factor(model->getTruthValue());
+}
+
+double MixtureModel::beta_factor(const TruthValuePtr& tv)
+{
+	BetaDistribution beta_dist(tv);
 	double factor = boost::math::beta(beta_dist.alpha(), beta_dist.beta());
 	LAZY_URE_LOG_FINE << "MixtureModel::beta_factor factor = " << factor;
 	return factor;
@@ -105,9 +160,13 @@ double MixtureModel::prior_estimate(const Handle& model) const
 {
 	LAZY_URE_LOG_FINE << "MixtureModel::prior_estimate model = " << model->id_to_string();
 
-	HandleSet all_atoms(get_all_uniq_atoms(model));
-	double partial_length = all_atoms.size(),
-		remain_data_size = data_set_size - model->getTruthValue()->get_count(),
+	return prior_estimate(ModelSummary(model));
+}
+
+double MixtureModel::prior_estimate(const ModelSummary& summary) const
+{
+	double partial_length = summary.length,
+		remain_data_size = data_set_size - summary.count,
 		kestimate = kolmogorov_estimate(remain_data_size);
 
 	LAZY_URE_LOG_FINE << "MixtureModel::prior_estimate "
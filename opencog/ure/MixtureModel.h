@@ -29,6 +29,44 @@
 namespace opencog
 {
 
+/**
+ * Quantities of a model that do not depend on the mixture it takes
+ * part in, and thus can be calculated once and for all, then reused
+ * across mixtures, in particular the length of the model (costly to
+ * calculate as it requires traversing it) and its beta factor.
+ */
+struct ModelSummary
+{
+	ModelSummary(const Handle& model);
+
+	/**
+	 * Update the quantities depending on the TV of the model, if it
+	 * has changed since the summary was made. The length is kept as
+	 * it only depends on the model definition.
+	 */
+	void set_tv(const TruthValuePtr& tv);
+
+	// TV of the model
+	TruthValuePtr tv;
+
+	// Length of the model, that is the number of unique atoms
+	// involved in its definition
+	double length;
+
+	// Count of the TV of the model
+	double count;
+
+	// Beta(alpha, beta) where alpha and beta are the parameters of
+	// the beta-distribution of the model TV
+	double beta_factor;
+
+	// Mean and variance of the beta-distribution of the model TV
+	double mean;
+	double variance;
+};
+
+typedef std::vector<ModelSummary> ModelSummarySeq;
+
 /**
  * Class containing methods to calculate the TruthValue of constructed
  * from the mixture of a set of active partial models. Since these
@@ -106,6 +144,22 @@ public:
 	 */
 	TruthValuePtr operator()() const;
 
+	/**
+	 * Like operator() but evaluate multiple mixture models in one
+	 * pass, using precomputed model summaries. Models are stored
+	 * contiguously, the ith mixture being made of the models in
+	 *
+	 * [summaries[offsets[i]], summaries[offsets[i+1]])
+	 *
+	 * thus offsets has one more element than the number of mixtures,
+	 * its first element being 0 and its last being
+	 * summaries.size(). Return the TV of each mixture.
+	 */
+	static std::vector<TruthValuePtr> mix(const ModelSummarySeq& summaries,
+	                                      const std::vector<size_t>& offsets,
+	                                      double cpx_penalty=1.0,
+	                                      double compressiveness=0.0);
+
 	/**
 	 * Given a list of TVs and a list of associated weights, that do
 	 * not need to sum up to 1, produce a TVs that approximates the
@@ -123,12 +177,14 @@ public:
 	 * return Beta(alpha, beta), where Beta is the beta function.
 	 */
 	double beta_factor(const Handle& model) const;
+	static double beta_factor(const TruthValuePtr& tv);
 
 	/**
 	 * Given a model, calculate it's prior estimate. In the case of a
 	 * partial model, the length is estimated
 	 */
 	double prior_estimate(const Handle& model) const;
+	double prior_estimate(const ModelSummary& summary) const;
 
 	/**
 	 * Given the size of the data set that isn't explained by a model,
@@ -160,6 +216,13 @@ public:
 	double prior(double length) const;
 
 private:
+	/**
+	 * Calculate the TV of the mixture of the models in [begin, end).
+	 */
+	static TruthValuePtr mix(ModelSummarySeq::const_iterator begin,
+	                         ModelSummarySeq::const_iterator end,
+	                         double cpx_penalty, double compressiveness);
+
 	/**
 	 * Infer the data set size by taking the max count of all models
 	 * (it works assuming that one of them is complete).
@@ -0,0 +1,99 @@
+/*
+ * PhaseTimers.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * Author: agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "PhaseTimers.h"
+
+#include <sstream>
+
+#include <opencog/atoms/value/FloatValue.h>
+#include <opencog/atoms/value/LinkValue.h>
+#include <opencog/atoms/value/StringValue.h>
+
+namespace opencog {
+
+const std::string PhaseTimers::key_name = "URE:phase-times";
+
+PhaseTimers::PhaseTimers(bool enabled) : _enabled(enabled) {}
+
+void PhaseTimers::set_enabled(bool enabled)
+{
+	_enabled = enabled;
+}
+
+void PhaseTimers::add(const std::string& phase, double seconds)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	Timing& timing = _timings[phase];
+	timing.seconds += seconds;
+	timing.count++;
+}
+
+PhaseTimers::Timings PhaseTimers::get_timings() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _timings;
+}
+
+PhaseTimers::Timing PhaseTimers::get_timing(const std::string& phase) const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto it = _timings.find(phase);
+	return it == _timings.end() ? Timing() : it->second;
+}
+
+ValuePtr PhaseTimers::to_value() const
+{
+	std::vector<std::string> phases;
+	std::vector<double> seconds, counts;
+	for (const auto& pt : get_timings()) {
+		phases.push_back(pt.first);
+		seconds.push_back(pt.second.seconds);
+		counts.push_back(pt.second.count);
+	}
+	return createLinkValue(ValueSeq{createStringValue(phases),
+	                                createFloatValue(seconds),
+	                                createFloatValue(counts)});
+}
+
+void PhaseTimers::clear()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_timings.clear();
+}
+
+std::string PhaseTimers::to_string(const std::string& indent) const
+{
+	std::stringstream ss;
+	ss << indent << "enabled = " << (_enabled ? "true" : "false");
+	for (const auto& pt : get_timings())
+		ss << std::endl << indent << pt.first << ": seconds = "
+		   << pt.second.seconds << ", count = " << pt.second.count;
+	return ss.str();
+}
+
+std::string oc_to_string(const PhaseTimers& pt, const std::string& indent)
+{
+	return pt.to_string(indent);
+}
+
+} // ~namespace opencog
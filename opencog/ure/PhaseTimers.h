@@ -0,0 +1,140 @@
+/*
+ * PhaseTimers.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * Author: agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#ifndef _OPENCOG_PHASETIMERS_H_
+#define _OPENCOG_PHASETIMERS_H_
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include <opencog/util/empty_string.h>
+#include <opencog/atoms/value/Value.h>
+
+namespace opencog
+{
+
+/**
+ * Wall-clock time spent, and number of calls, in each phase of an
+ * inference run, such as source selection or rule application,
+ * aggregated over the whole run and all its threads.
+ *
+ * Phases are timed by instantiating a PhaseTimers::Scope at their
+ * beginning, which does nothing when the timers are disabled, their
+ * default. Phases may be nested, in which case the time of the inner
+ * phase is also counted in the outer one.
+ */
+class PhaseTimers
+{
+public:
+	// Accumulated time in seconds and number of calls of a phase
+	struct Timing
+	{
+		double seconds = 0.0;
+		size_t count = 0;
+	};
+	typedef std::map<std::string, Timing> Timings;
+
+	/**
+	 * Time the current scope as the given phase, if the timers are
+	 * enabled.
+	 */
+	class Scope
+	{
+	public:
+		Scope(PhaseTimers& timers, const char* phase)
+			: _timers(timers.is_enabled() ? &timers : nullptr), _phase(phase)
+		{
+			if (_timers)
+				_start = std::chrono::steady_clock::now();
+		}
+
+		~Scope()
+		{
+			if (_timers) {
+				std::chrono::duration<double> elapsed =
+					std::chrono::steady_clock::now() - _start;
+				_timers->add(_phase, elapsed.count());
+			}
+		}
+
+	private:
+		PhaseTimers* _timers;
+		const char* _phase;
+		std::chrono::steady_clock::time_point _start;
+	};
+
+	PhaseTimers(bool enabled=false);
+
+	void set_enabled(bool enabled);
+	bool is_enabled() const { return _enabled; }
+
+	/**
+	 * Add a call of the given duration to a phase.
+	 */
+	void add(const std::string& phase, double seconds);
+
+	/**
+	 * Return the timings of all phases that have been called at
+	 * least once, or of a given phase.
+	 */
+	Timings get_timings() const;
+	Timing get_timing(const std::string& phase) const;
+
+	/**
+	 * Return the timings as a LinkValue of three values, the phase
+	 * names, their times in seconds and their numbers of calls, i.e.
+	 *
+	 * LinkValue
+	 *   StringValue <phase_1> ... <phase_n>
+	 *   FloatValue <seconds_1> ... <seconds_n>
+	 *   FloatValue <count_1> ... <count_n>
+	 */
+	ValuePtr to_value() const;
+
+	void clear();
+
+	std::string to_string(const std::string& indent=empty_string) const;
+
+	// Name of the PredicateNode under which the timings of a run are
+	// attached to its rule base by cog-fc and cog-bc, see to_value.
+	static const std::string key_name;
+
+private:
+	std::atomic<bool> _enabled;
+	Timings _timings;
+	mutable std::mutex _mutex;
+};
+
+// Debugging helpers see
+// http://wiki.opencog.org/w/Development_standards#Print_OpenCog_Objects
+// The reason indent is not an optional argument with default is
+// because gdb doesn't support that, see
+// http://stackoverflow.com/questions/16734783 for more explanation.
+std::string oc_to_string(const PhaseTimers& pt,
+                         const std::string& indent=empty_string);
+
+} // namespace opencog
+
+#endif /* _OPENCOG_PHASETIMERS_H_ */
@@ -28,21 +28,23 @@
 #include <boost/uuid/uuid_io.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/algorithm/cxx11/any_of.hpp>
-#include <boost/range/algorithm/binary_search.hpp>
 #include <boost/range/algorithm/lower_bound.hpp>
 
 #include <opencog/util/oc_assert.h>
 #include <opencog/atoms/base/Link.h>
 #include <opencog/atoms/base/Node.h>
 #include <opencog/atoms/core/DefineLink.h>
+#include <opencog/atoms/core/FindUtils.h>
 #include <opencog/atoms/core/Quotation.h>
 #include <opencog/atoms/core/TypeUtils.h>
 #include <opencog/atoms/pattern/BindLink.h>
 
 #include <opencog/atomspace/AtomSpace.h>
 #include <opencog/unify/Unify.h>
+#include <opencog/unify/UnifyCache.h>
 
 #include "URELogger.h"
+#include "MetaRuleWatcher.h"
 
 #include "Rule.h"
 
@@ -53,16 +55,41 @@ bool rule_ptr_less::operator()(const RulePtr& l, const RulePtr& r) const
 	return *l < *r;
 }
 
+size_t rule_ptr_hash::operator()(const RulePtr& rule) const
+{
+	Handle body = rule->get_rule();
+	return body ? body->get_hash() : 0;
+}
+
+bool rule_ptr_equal::operator()(const RulePtr& l, const RulePtr& r) const
+{
+	return *l == *r;
+}
+
+RuleSet::RuleSet(const RuleSet& other) : super(other)
+{
+}
+
+RuleSet& RuleSet::operator=(const RuleSet& other)
+{
+	super::operator=(other);
+	_meta_rule_watcher.reset();
+	return *this;
+}
+
 void RuleSet::expand_meta_rules(AtomSpace& as)
 {
-	// TODO: could certainly be optimized by not systematically
-	// recollecting and re-instantiating meta-rules.
+	// Changes are only tracked over the atomspace being watched, a
+	// new watcher considers all meta rules changed.
+	if (not _meta_rule_watcher or &_meta_rule_watcher->get_atomspace() != &as)
+		_meta_rule_watcher = std::make_shared<MetaRuleWatcher>(as);
+
+	// Collect the meta rules with atoms to match that have changed
+	// since their last expansion
 	RuleSet meta_rules;
-	for (RulePtr rule : *this) {
-		if (rule->is_meta()) {
+	for (RulePtr rule : *this)
+		if (rule->is_meta() and _meta_rule_watcher->take_changed(rule))
 			meta_rules.insert(rule);
-		}
-	}
 
 	for (RulePtr rule : meta_rules) {
 		Handle result = rule->apply(as);
@@ -88,10 +115,10 @@ HandleSet RuleSet::aliases() const
 
 std::pair<RuleSet::iterator, bool> RuleSet::insert(RulePtr rule)
 {
-	if (boost::binary_search(*this, rule, rule_ptr_less()))
+	RuleSet::iterator it = boost::lower_bound(*this, rule, rule_ptr_less());
+	if (it != end() and not rule_ptr_less()(rule, *it))
 		return {end(), false};
 
-	RuleSet::iterator it = boost::lower_bound(*this, rule, rule_ptr_less());
 	it = super::insert(it, rule);
 	return {it, true};
 }
@@ -116,16 +143,18 @@ bool RuleSet::operator<(const RuleSet& other) const
 
 RuleSet::iterator RuleSet::find(const RulePtr& rule)
 {
-	if (not boost::binary_search(*this, rule, rule_ptr_less()))
+	RuleSet::iterator it = boost::lower_bound(*this, rule, rule_ptr_less());
+	if (it == end() or rule_ptr_less()(rule, *it))
 		return end();
-	return boost::lower_bound(*this, rule, rule_ptr_less());
+	return it;
 }
 
 RuleSet::const_iterator RuleSet::find(const RulePtr& rule) const
 {
-	if (not boost::binary_search(*this, rule, rule_ptr_less()))
+	RuleSet::const_iterator it = boost::lower_bound(*this, rule, rule_ptr_less());
+	if (it == cend() or rule_ptr_less()(rule, *it))
 		return cend();
-	return boost::lower_bound(*this, rule, rule_ptr_less());
+	return it;
 }
 
 TruthValueSeq RuleSet::get_tvs() const
@@ -158,6 +187,17 @@ std::string RuleSet::to_short_string(const std::string& indent) const
 	return ss.str();
 }
 
+std::string HashedRuleSet::to_short_string(const std::string& indent) const
+{
+	std::stringstream ss;
+	ss << indent << "size = " << size();
+	size_t i = 0;
+	for (const auto& rule : *this)
+		ss << std::endl << indent << "rule[" << i++ << "]:" << std::endl
+		   << rule->to_short_string(indent + oc_to_string_indent);
+	return ss.str();
+}
+
 Rule::Rule()
 	: premises_as_clauses(false), _rule_alias(Handle::UNDEFINED), _exhausted(false) {}
 
@@ -176,6 +216,9 @@ Rule::Rule(const Rule& r)
 	_rbs = r._rbs;
 	_tv = r._tv;
 	_exhausted = r._exhausted;
+	std::lock_guard<std::mutex> lock(r._mutex);
+	_alpha_variants = r._alpha_variants;
+	_constant_clauses = r._constant_clauses;
 }
 
 Rule::Rule(const Handle& rule_alias, const Handle& rbs)
@@ -213,6 +256,8 @@ void Rule::init(const Handle& rule_alias, const Handle& rule, const Handle& rbs)
 {
 	OC_ASSERT(rule->get_type() == BIND_LINK);
 	_rule = BindLinkCast(rule);
+	_alpha_variants = nullptr;
+	_constant_clauses = nullptr;
 
 	_rule_alias = rule_alias;
 	_name = _rule_alias->get_name();
@@ -267,6 +312,11 @@ Rule& Rule::operator=(const Rule& r)
 	_rbs = r._rbs;
 	_tv = r._tv;
 	_exhausted = r._exhausted;
+	if (this != &r) {
+		std::lock_guard<std::mutex> lock(r._mutex);
+		_alpha_variants = r._alpha_variants;
+		_constant_clauses = r._constant_clauses;
+	}
 
 	return *this;
 }
@@ -294,6 +344,8 @@ const std::string& Rule::get_name() const
 void Rule::set_rule(const Handle& h)
 {
 	_rule = BindLinkCast(h);
+	_alpha_variants = nullptr;
+	_constant_clauses = nullptr;
 }
 
 Handle Rule::get_rule() const
@@ -512,35 +564,34 @@ HandlePairSeq Rule::get_conclusions() const
 
 RuleTypedSubstitutionMap Rule::unify_source(const Handle& source,
                                             const Handle& vardecl,
-                                            const AtomSpace* queried_as) const
+                                            const AtomSpace* queried_as,
+                                            UnifyCache* unify_cache) const
 {
 	// If the rule's handle has not been set yet
 	if (not is_valid())
 		return {};
 
 	// To guarantee that the rule variable does not have the same name
-	// as any variable in the source. XXX This is only a stochastic
-	// guarantee, there is a small chance that the new random name
-	// will still collide.
-	Rule alpha_rule = rand_alpha_converted();
+	// as any variable in the source.
+	auto [alpha_body, premises] = alpha_converted(source, vardecl, false);
 
+	RulePtr base = get_base();
 	RuleTypedSubstitutionMap unified_rules;
-	Handle rule_vardecl = alpha_rule.get_vardecl();
-	for (const Handle& premise : alpha_rule.get_premises())
+	Handle rule_vardecl = alpha_body->get_variables().get_vardecl();
+	for (const Handle& premise : premises)
 	{
-		Unify unify(source, premise, vardecl, rule_vardecl);
-		Unify::SolutionSet sol = unify();
-		if (sol.is_satisfiable()) {
-			Unify::TypedSubstitutions tss =
-				unify.typed_substitutions(sol, source);
-			// For each typed substitution produce a new rule by
-			// substituting all variables by their associated
-			// values.
-			for (const auto& ts : tss) {
-				Rule sed_rule = alpha_rule.substituted(ts, queried_as);
-				RuleTypedSubstitutionPair rtsp{sed_rule, ts};
-				unified_rules.insert(rtsp);
-			}
+		// Most premises do not unify, rule them out cheaply
+		if (not structurally_unifiable(source, premise))
+			continue;
+
+		Unify::TypedSubstitutions tss =
+			UnifyCache::typed_substitutions(unify_cache, source, premise,
+			                                vardecl, rule_vardecl);
+		// For each typed substitution produce a new rule view by
+		// substituting all variables by their associated values.
+		for (const auto& ts : tss) {
+			RuleView sed_rule(base, Unify::substitute(alpha_body, ts, queried_as));
+			unified_rules.insert({sed_rule, ts});
 		}
 	}
 
@@ -549,35 +600,34 @@ RuleTypedSubstitutionMap Rule::unify_source(const Handle& source,
 
 RuleTypedSubstitutionMap Rule::unify_target(const Handle& target,
                                             const Handle& vardecl,
-                                            const AtomSpace* queried_as) const
+                                            const AtomSpace* queried_as,
+                                            UnifyCache* unify_cache) const
 {
 	// If the rule's handle has not been set yet
 	if (not is_valid())
 		return {};
 
 	// To guarantee that the rule variable does not have the same name
-	// as any variable in the target. XXX This is only a stochastic
-	// guarantee, there is a small chance that the new random name
-	// will still collide.
-	Rule alpha_rule = rand_alpha_converted();
+	// as any variable in the target.
+	auto [alpha_body, alpha_pats] = alpha_converted(target, vardecl, true);
 
+	RulePtr base = get_base();
 	RuleTypedSubstitutionMap unified_rules;
-	Handle alpha_vardecl = alpha_rule.get_vardecl();
-	for (const Handle& alpha_pat : alpha_rule.get_conclusion_patterns())
+	Handle alpha_vardecl = alpha_body->get_variables().get_vardecl();
+	for (const Handle& alpha_pat : alpha_pats)
 	{
-		Unify unify(target, alpha_pat, vardecl, alpha_vardecl);
-		Unify::SolutionSet sol = unify();
-		if (sol.is_satisfiable()) {
-			Unify::TypedSubstitutions tss =
-				unify.typed_substitutions(sol, target);
-			// For each typed substitution produce a new rule by
-			// substituting all variables by their associated
-			// values.
-			for (const auto& ts : tss) {
-				Rule sed_rule = alpha_rule.substituted(ts, queried_as);
-				RuleTypedSubstitutionPair rtsp{sed_rule, ts};
-				unified_rules.insert(rtsp);
-			}
+		// Most conclusions do not unify, rule them out cheaply
+		if (not structurally_unifiable(target, alpha_pat))
+			continue;
+
+		Unify::TypedSubstitutions tss =
+			UnifyCache::typed_substitutions(unify_cache, target, alpha_pat,
+			                                vardecl, alpha_vardecl);
+		// For each typed substitution produce a new rule view by
+		// substituting all variables by their associated values.
+		for (const auto& ts : tss) {
+			RuleView sed_rule(base, Unify::substitute(alpha_body, ts, queried_as));
+			unified_rules.insert({sed_rule, ts});
 		}
 	}
 
@@ -588,16 +638,46 @@ RuleSet Rule::strip_typed_substitution(const RuleTypedSubstitutionMap& rtsm)
 {
 	RuleSet rs;
 	for (const auto& r : rtsm)
-		rs.insert(createRule(r.first));
+		rs.insert(createRule(r.first.to_rule()));
 
 	return rs;
 }
 
+bool Rule::is_applicable(const AtomSpace& as) const
+{
+	for (const Handle& clause : *get_constant_clauses())
+		if (as.get_atom(clause) == Handle::UNDEFINED)
+			return false;
+	return true;
+}
+
 Handle Rule::apply(AtomSpace& as) const
 {
 	return HandleCast(_rule->execute(&as));
 }
 
+std::shared_ptr<const HandleSeq> Rule::get_constant_clauses() const
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (_constant_clauses)
+			return _constant_clauses;
+	}
+
+	// Calculate outside of the lock, in the worst case concurrent
+	// callers calculate the same clauses twice.
+	auto ccs = std::make_shared<HandleSeq>();
+	const HandleSet& varset = get_variables().varset;
+	for (const Handle& clause : get_clauses())
+		if (is_constant(varset, clause))
+			ccs->push_back(clause);
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	if (not _constant_clauses)
+		_constant_clauses = ccs;
+	return _constant_clauses;
+}
+
 void Rule::set_exhausted()
 {
 	std::lock_guard<std::mutex> lock(_mutex);
@@ -635,15 +715,79 @@ std::string Rule::to_short_string(const std::string& indent) const
 	return ss.str();
 }
 
-Rule Rule::rand_alpha_converted() const
+std::pair<BindLinkPtr, HandleSeq> Rule::alpha_converted(const Handle& h,
+                                                       const Handle& vardecl,
+                                                       bool conclusion) const
+{
+	std::shared_ptr<AlphaVariants> avs;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (not _alpha_variants)
+			_alpha_variants = std::make_shared<AlphaVariants>();
+		avs = _alpha_variants;
+	}
+
+	// Find the first variant with no variable in common with h and
+	// vardecl, or build a new one. The number of variants is bounded
+	// by the number of times the rule is nested in h, usually small.
+	std::lock_guard<std::mutex> lock(avs->mutex);
+	AlphaVariant* alpha_variant = nullptr;
+	for (AlphaVariant& av : avs->variants) {
+		if (not any_atom_in_tree(h, av.variables)
+		    and (not vardecl or not any_atom_in_tree(vardecl, av.variables))) {
+			alpha_variant = &av;
+			break;
+		}
+	}
+	if (not alpha_variant) {
+		avs->variants.push_back(mk_alpha_variant(avs->variants.size()));
+		alpha_variant = &avs->variants.back();
+	}
+
+	if (conclusion)
+		return {alpha_variant->rule, alpha_variant->conclusion_patterns};
+
+	// Premises must be recalculated if premises_as_clauses has
+	// changed since.
+	if (alpha_variant->premises_as_clauses != premises_as_clauses) {
+		Rule alpha_rule(*this);
+		alpha_rule.set_rule(Handle(alpha_variant->rule));
+		alpha_variant->premises_as_clauses = premises_as_clauses;
+		alpha_variant->premises = alpha_rule.get_premises();
+	}
+	return {alpha_variant->rule, alpha_variant->premises};
+}
+
+Rule::AlphaVariant Rule::mk_alpha_variant(size_t k) const
 {
-	// Clone the rule
-	Rule result(*this);
+	std::stringstream prefix;
+	prefix << "$ure-alpha-" << k << "-" << std::hex << _rule->get_hash() << "-";
 
-	// Alpha convert the rule
-	result.set_rule(_rule->alpha_convert());
+	AlphaVariant av;
+	HandleSeq vars;
+	const HandleSeq& varseq = _rule->get_variables().varseq;
+	for (size_t i = 0; i < varseq.size(); i++) {
+		Handle var = createNode(varseq[i]->get_type(),
+		                        prefix.str() + std::to_string(i));
+		vars.push_back(var);
+		av.variables.insert(var);
+	}
+	av.rule = BindLinkCast(_rule->alpha_convert(vars));
 
-	return result;
+	// Precompute its premises and conclusion patterns
+	Rule alpha_rule(*this);
+	alpha_rule.set_rule(Handle(av.rule));
+	av.premises_as_clauses = premises_as_clauses;
+	av.premises = alpha_rule.get_premises();
+	av.conclusion_patterns = alpha_rule.get_conclusion_patterns();
+	return av;
+}
+
+RulePtr Rule::get_base() const
+{
+	// Rule views do not modify their base, so constness is preserved
+	RulePtr base = std::const_pointer_cast<Rule>(weak_from_this().lock());
+	return base ? base : createRule(*this);
 }
 
 HandleSeq Rule::get_conclusion_patterns() const
@@ -688,6 +832,90 @@ Rule Rule::substituted(const Unify::TypedSubstitution& ts,
 	return new_rule;
 }
 
+RuleView::RuleView() : _hash(0) {}
+
+RuleView::RuleView(const RulePtr& base, const Handle& body)
+	: _base(base), _body(BindLinkCast(body)), _hash(body->get_hash()) {}
+
+bool RuleView::operator==(const RuleView& other) const
+{
+	return _hash == other._hash
+		and content_eq(Handle(_body), Handle(other._body));
+}
+
+bool RuleView::operator!=(const RuleView& other) const
+{
+	return not (*this == other);
+}
+
+const RulePtr& RuleView::get_base() const
+{
+	return _base;
+}
+
+Handle RuleView::get_rule() const
+{
+	return Handle(_body);
+}
+
+Handle RuleView::get_vardecl() const
+{
+	if (_body)
+		return _body->get_variables().get_vardecl();
+	return Handle::UNDEFINED;
+}
+
+Handle RuleView::get_alias() const
+{
+	return _base->get_alias();
+}
+
+const std::string& RuleView::get_name() const
+{
+	return _base->get_name();
+}
+
+Handle RuleView::get_rbs() const
+{
+	return _base->get_rbs();
+}
+
+TruthValuePtr RuleView::get_tv() const
+{
+	return _base->get_tv();
+}
+
+size_t RuleView::get_hash() const
+{
+	return _hash;
+}
+
+Rule RuleView::to_rule() const
+{
+	if (not _base)
+		return Rule();
+	Rule rule(*_base);
+	rule.set_rule(Handle(_body));
+	return rule;
+}
+
+std::string RuleView::to_string(const std::string& indent) const
+{
+	return to_rule().to_string(indent);
+}
+
+std::string RuleView::to_short_string(const std::string& indent) const
+{
+	std::stringstream ss;
+	ss << indent << get_name() << " " << _body->id_to_string();
+	return ss.str();
+}
+
+size_t rule_view_hash::operator()(const RuleView& rv) const
+{
+	return rv.get_hash();
+}
+
 std::string oc_to_string(const Rule& rule, const std::string& indent)
 {
 	return rule.to_string(indent);
@@ -696,6 +924,10 @@ std::string oc_to_string(const RuleSet& rules, const std::string& indent)
 {
 	return rules.to_string(indent);
 }
+std::string oc_to_string(const RuleView& rule_view, const std::string& indent)
+{
+	return rule_view.to_string(indent);
+}
 std::string oc_to_string(const RuleTypedSubstitutionPair& rule_ts,
                          const std::string& indent)
 {
@@ -26,6 +26,9 @@
 #ifndef _OPENCOG_RULE_H_
 #define _OPENCOG_RULE_H_
 
+#include <unordered_map>
+#include <unordered_set>
+
 #include <boost/operators.hpp>
 #include <opencog/atomspace/AtomSpace.h>
 #include <opencog/atoms/core/ScopeLink.h>
@@ -39,11 +42,21 @@ namespace opencog {
 
 class Rule;
 typedef std::shared_ptr<Rule> RulePtr;
+class MetaRuleWatcher;
+class UnifyCache;
 #define createRule std::make_shared<Rule>
 struct rule_ptr_less
 {
 	bool operator()(const RulePtr& l, const RulePtr& r) const;
 };
+struct rule_ptr_hash
+{
+	size_t operator()(const RulePtr& rule) const;
+};
+struct rule_ptr_equal
+{
+	bool operator()(const RulePtr& l, const RulePtr& r) const;
+};
 
 /**
  * The rule set is in fact a sorted vector, as to be able to change
@@ -58,9 +71,26 @@ class RuleSet : public std::vector<RulePtr>,
 	typedef std::vector<RulePtr> super;
 
 public:
+	RuleSet() = default;
+	RuleSet(RuleSet&&) = default;
+	RuleSet& operator=(RuleSet&&) = default;
+
+	/**
+	 * Copy the rules, but not the state of the meta rule expansion,
+	 * which is specific to a rule set.
+	 */
+	RuleSet(const RuleSet& other);
+	RuleSet& operator=(const RuleSet& other);
+
 	/**
 	 * Run all meta rules over as and insert the resulting rules back
 	 * in the rule set.
+	 *
+	 * Expansion is incremental, a meta rule is only re-run if atoms
+	 * it may match have been added to (or removed from) as, or have
+	 * had their TVs changed, since its last run, see
+	 * MetaRuleWatcher. Calling it repeatedly over an unchanged
+	 * atomspace costs nothing. as must outlive the rule set.
 	 */
 	void expand_meta_rules(AtomSpace& as);
 
@@ -109,11 +139,82 @@ public:
 
 	std::string to_string(const std::string& indent=empty_string) const;
 	std::string to_short_string(const std::string& indent=empty_string) const;
+
+private:
+	// Changes of the atomspace over which meta rules have been last
+	// expanded
+	std::shared_ptr<MetaRuleWatcher> _meta_rule_watcher;
 };
 
-typedef std::map<Rule, Unify::TypedSubstitution> RuleTypedSubstitutionMap;
+/**
+ * Lightweight view over a rule specialization, as produced by
+ * unification. Rather than copying the whole Rule, it holds a pointer
+ * to the rule it is a specialization of (providing its name, alias,
+ * TV, etc), its substituted body, and the content hash of that body,
+ * so that it can be cheaply copied, hashed and compared.
+ *
+ * A full Rule can be obtained with to_rule() when needed, such as to
+ * expand a BIT.
+ */
+class RuleView
+{
+public:
+	RuleView();
+	RuleView(const RulePtr& base, const Handle& body);
+
+	/**
+	 * Content-based (including alpha-equivalence) comparison of the
+	 * bodies.
+	 */
+	bool operator==(const RuleView& other) const;
+	bool operator!=(const RuleView& other) const;
+
+	const RulePtr& get_base() const;
+	Handle get_rule() const;
+	Handle get_vardecl() const;
+	Handle get_alias() const;
+	const std::string& get_name() const;
+	Handle get_rbs() const;
+	TruthValuePtr get_tv() const;
+	size_t get_hash() const;
+
+	/**
+	 * Build the full rule corresponding to that view.
+	 */
+	Rule to_rule() const;
+
+	std::string to_string(const std::string& indent=empty_string) const;
+	std::string to_short_string(const std::string& indent=empty_string) const;
+
+private:
+	RulePtr _base;
+	BindLinkPtr _body;
+	size_t _hash;
+};
+
+struct rule_view_hash
+{
+	size_t operator()(const RuleView& rv) const;
+};
+
+typedef std::unordered_map<RuleView, Unify::TypedSubstitution, rule_view_hash>
+RuleTypedSubstitutionMap;
 typedef RuleTypedSubstitutionMap::value_type RuleTypedSubstitutionPair;
 
+/**
+ * Like RuleSet but indexed by the content hash of the rule bodies, with
+ * alpha-equivalence aware equality, offering constant time
+ * insertion and lookup. Unlike RuleSet it is unordered, it is meant
+ * for sets that are mostly queried, such as the rules tried so far
+ * on a source.
+ */
+class HashedRuleSet : public std::unordered_set<RulePtr, rule_ptr_hash,
+                                                rule_ptr_equal>
+{
+public:
+	std::string to_short_string(const std::string& indent=empty_string) const;
+};
+
 /**
  * Class for managing rules in the URE.
  *
@@ -154,7 +255,8 @@ typedef RuleTypedSubstitutionMap::value_type RuleTypedSubstitutionPair;
  * Also, unordered premises can be wrapped in SetLink as this may
  * speed up a bit the Backward Chainer.
  */
-class Rule : public boost::totally_ordered<Rule>
+class Rule : public boost::totally_ordered<Rule>,
+             public std::enable_shared_from_this<Rule>
 {
 public:
 	/**
@@ -276,7 +378,8 @@ public:
 	 * Used by the forward chainer to select rules. Given a source,
 	 * generate all rule variations that may be applied over a given
 	 * source. The variables in the rules are renamed to almost
-	 * certainly avoid name collision.
+	 * certainly avoid name collision. If unify_cache is provided, the
+	 * unifications are looked up in it, see UnifyCache.
 	 *
 	 * TODO: we probably want to support a vector of sources for rules
 	 * with multiple premises.
@@ -293,12 +396,14 @@ public:
 	 */
 	RuleTypedSubstitutionMap unify_source(const Handle& source,
 	                                      const Handle& vardecl=Handle::UNDEFINED,
-	                                      const AtomSpace* queried_as=nullptr) const;
+	                                      const AtomSpace* queried_as=nullptr,
+	                                      UnifyCache* unify_cache=nullptr) const;
 
 	/**
 	 * Used by the backward chainer. Given a target, generate all rule
 	 * variations that may infer this target. The variables in the
-	 * rules are renamed to almost certainly avoid name collision.
+	 * rules are renamed to avoid name collision. If unify_cache is
+	 * provided, the unifications are looked up in it.
 	 *
 	 * TODO: we probably want to return only typed substitutions.
 	 * However due to the unifier not supporting well same variables
@@ -308,7 +413,8 @@ public:
 	 */
 	 RuleTypedSubstitutionMap unify_target(const Handle& target,
 	                                       const Handle& vardecl=Handle::UNDEFINED,
-	                                       const AtomSpace* queried_as=nullptr) const;
+	                                       const AtomSpace* queried_as=nullptr,
+	                                       UnifyCache* unify_cache=nullptr) const;
 
 	/**
 	 * Remove the typed substitutions from the rule typed substitution
@@ -316,6 +422,13 @@ public:
 	 */
 	static RuleSet strip_typed_substitution(const RuleTypedSubstitutionMap& rules);
 
+	/**
+	 * Return true if all constant clauses of the rule are present in
+	 * as. Unification might have created constant clauses which are
+	 * not, in which case applying the rule over as is pointless.
+	 */
+	bool is_applicable(const AtomSpace& as) const;
+
 	/**
 	 * Apply rule (in a forward way) over atomspace as.
 	 */
@@ -373,9 +486,57 @@ private:
 	// TODO: subdivide in smaller and shared mutexes
 	mutable std::mutex _mutex;
 
-	// Return a copy of the rule with the variables alpha-converted
-	// into random variable names.
-	Rule rand_alpha_converted() const;
+	// Alpha-converted variants of the rule, with variables named in
+	// a reserved namespace, precomputed so that unification does not
+	// need to create atoms. Shared by all copies of the rule with the
+	// same _rule, and reset whenever _rule changes.
+	struct AlphaVariant
+	{
+		HandleSet variables;
+		BindLinkPtr rule;
+
+		// Premises and conclusion patterns of the variant, premises
+		// depend on premises_as_clauses, thus the flag they have
+		// been calculated with.
+		bool premises_as_clauses;
+		HandleSeq premises;
+		HandleSeq conclusion_patterns;
+	};
+	struct AlphaVariants
+	{
+		std::mutex mutex;
+		std::vector<AlphaVariant> variants;
+	};
+	mutable std::shared_ptr<AlphaVariants> _alpha_variants;
+
+	// Constant clauses of the rule, calculated once per _rule, so
+	// that repeatedly applying it only needs to look them up. Like
+	// _alpha_variants it is shared by all copies of the rule with the
+	// same _rule, and reset whenever _rule changes.
+	mutable std::shared_ptr<const HandleSeq> _constant_clauses;
+
+	// Return the constant clauses of the rule, calculating them if
+	// needed.
+	std::shared_ptr<const HandleSeq> get_constant_clauses() const;
+
+	// Return the body of the rule alpha-converted so that none of its
+	// variables appear in h or vardecl, alongside its premises (or
+	// conclusion patterns if conclusion is true). The first
+	// precomputed variant satisfying that is used, if none does a new
+	// variant is added.
+	std::pair<BindLinkPtr, HandleSeq> alpha_converted(const Handle& h,
+	                                                  const Handle& vardecl,
+	                                                  bool conclusion) const;
+
+	// Return the pointer of that rule if owned by one, or a pointer
+	// to a copy of it otherwise, to be used as base of rule views.
+	RulePtr get_base() const;
+
+	// Build the k-th alpha-converted variant of the rule, its variables
+	// being deterministically named
+	//
+	// $ure-alpha-<k>-<rule hash>-<variable index>
+	AlphaVariant mk_alpha_variant(size_t k) const;
 
 	// Return the conclusion patterns of the rule. There are several
 	// of them because the conclusions can be wrapped in the
@@ -402,6 +563,8 @@ std::string oc_to_string(const Rule& rule,
                          const std::string& indent=empty_string);
 std::string oc_to_string(const RuleSet& rules,
                          const std::string& indent=empty_string);
+std::string oc_to_string(const RuleView& rule_view,
+                         const std::string& indent=empty_string);
 std::string oc_to_string(const RuleTypedSubstitutionPair& rule_ts_pair,
                          const std::string& indent=empty_string);
 std::string oc_to_string(const RuleTypedSubstitutionMap& rule_ts_map,
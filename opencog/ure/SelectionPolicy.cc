@@ -0,0 +1,151 @@
+/*
+ * SelectionPolicy.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * Author: agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "SelectionPolicy.h"
+
+#include <opencog/util/exceptions.h>
+#include <opencog/util/oc_assert.h>
+
+#include "BetaDistribution.h"
+#include "ThompsonSampling.h"
+
+namespace opencog {
+
+PolicySelection::PolicySelection(const TruthValueSeq& tvs,
+                                 SelectionPolicy policy,
+                                 unsigned tournament_size,
+                                 double ucb_quantile)
+	: _tvs(tvs), _policy(policy),
+	  _tournament_size(std::max(1U, tournament_size)),
+	  _ucb_quantile(ucb_quantile) {}
+
+size_t PolicySelection::operator()(RandGen& rng) const
+{
+	switch (_policy) {
+	case SelectionPolicy::Thompson:
+	case SelectionPolicy::SingleDrawThompson:
+		return thompson(rng);
+	case SelectionPolicy::BayesUCB:
+		return bayes_ucb(rng);
+	case SelectionPolicy::Tournament:
+		return tournament(rng);
+	}
+	OC_ASSERT(false, "Unknown selection policy");
+	return 0;
+}
+
+size_t PolicySelection::thompson(RandGen& rng) const
+{
+	return ThompsonSampling(_tvs)(rng);
+}
+
+size_t PolicySelection::bayes_ucb(RandGen& rng) const
+{
+	OC_ASSERT(not _tvs.empty());
+
+	// Cheap trivial case
+	if (_tvs.size() == 1)
+		return 0;
+
+	// Collect the indices of the maxima of the upper quantiles
+	double max_q = -1.0;
+	std::vector<size_t> maxima;
+	for (size_t i = 0; i < _tvs.size(); i++) {
+		double q = BetaDistribution(_tvs[i]).quantile(_ucb_quantile);
+		if (max_q < q) {
+			max_q = q;
+			maxima.clear();
+		}
+		if (q == max_q)
+			maxima.push_back(i);
+	}
+	return maxima[rng.randint(maxima.size())];
+}
+
+size_t PolicySelection::tournament(RandGen& rng) const
+{
+	OC_ASSERT(not _tvs.empty());
+
+	// Cheap trivial case
+	if (_tvs.size() == 1)
+		return 0;
+
+	size_t winner = rng.randint(_tvs.size());
+	double winner_mean = BetaDistribution(_tvs[winner]).mean();
+	for (unsigned i = 1; i < _tournament_size; i++) {
+		size_t contender = rng.randint(_tvs.size());
+		double contender_mean = BetaDistribution(_tvs[contender]).mean();
+		if (winner_mean < contender_mean) {
+			winner = contender;
+			winner_mean = contender_mean;
+		}
+	}
+	return winner;
+}
+
+std::string PolicySelection::to_string(const std::string& indent) const
+{
+	std::stringstream ss;
+	ss << indent << "policy: " << oc_to_string(_policy) << std::endl
+	   << indent << "tournament_size: " << _tournament_size << std::endl
+	   << indent << "ucb_quantile: " << _ucb_quantile << std::endl
+	   << indent << "tvs:" << std::endl
+	   << oc_to_string(_tvs, indent + OC_TO_STRING_INDENT);
+	return ss.str();
+}
+
+SelectionPolicy to_selection_policy(int value)
+{
+	switch (value) {
+	case (int)SelectionPolicy::Thompson:
+	case (int)SelectionPolicy::SingleDrawThompson:
+	case (int)SelectionPolicy::BayesUCB:
+	case (int)SelectionPolicy::Tournament:
+		return (SelectionPolicy)value;
+	default:
+		throw RuntimeException(TRACE_INFO,
+		                       "Unknown selection policy %d", value);
+	}
+}
+
+std::string oc_to_string(SelectionPolicy policy, const std::string& indent)
+{
+	switch (policy) {
+	case SelectionPolicy::Thompson:
+		return indent + "Thompson";
+	case SelectionPolicy::SingleDrawThompson:
+		return indent + "SingleDrawThompson";
+	case SelectionPolicy::BayesUCB:
+		return indent + "BayesUCB";
+	case SelectionPolicy::Tournament:
+		return indent + "Tournament";
+	}
+	return indent + "Unknown";
+}
+
+std::string oc_to_string(const PolicySelection& psel, const std::string& indent)
+{
+	return psel.to_string(indent);
+}
+
+} // ~namespace opencog
@@ -0,0 +1,137 @@
+/*
+ * SelectionPolicy.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * Author: agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#ifndef _OPENCOG_SELECTION_POLICY_H_
+#define _OPENCOG_SELECTION_POLICY_H_
+
+#include <opencog/util/mt19937ar.h>
+#include <opencog/util/empty_string.h>
+#include <opencog/atoms/truthvalue/TruthValue.h>
+
+namespace opencog
+{
+
+/**
+ * Policies to select an action (inference rule, source rule pair,
+ * etc) given the TVs that each action fulfills the objective of
+ * interest. The numerical values are the ones used by the
+ * URE:selection-policy parameter.
+ */
+enum class SelectionPolicy
+{
+	// Thompson sampling. Whenever the selection distribution is
+	// required (for instance by the backward chainer to spread the
+	// probability of a rule alias over its instances) it is
+	// calculated by numerical integration, see
+	// ThompsonSampling::distribution(), which can be costly.
+	Thompson = 0,
+
+	// Thompson sampling performed by drawing a single first order
+	// probability per TV and picking the maximum, never building
+	// the selection distribution.
+	SingleDrawThompson = 1,
+
+	// Bayes-UCB, pick the action with the highest upper quantile of
+	// the beta-distribution of its TV. Deterministic, except for
+	// ties.
+	BayesUCB = 2,
+
+	// Tournament selection, draw a few actions uniformly at random
+	// and pick the one with the highest mean. Cheapest, especially
+	// with large number of actions.
+	Tournament = 3
+};
+
+/**
+ * Class to select an index according to a given selection policy,
+ * given the TVs that each index corresponds to an action that
+ * fulfills the objective of interest.
+ */
+class PolicySelection
+{
+public:
+	/**
+	 * CTor
+	 *
+	 * @param tvs             Sequence of TruthValues, one per index.
+	 * @param policy          Selection policy.
+	 * @param tournament_size Number of contenders for tournament selection.
+	 * @param ucb_quantile    Quantile used by Bayes-UCB.
+	 */
+	PolicySelection(const TruthValueSeq& tvs,
+	                SelectionPolicy policy=SelectionPolicy::SingleDrawThompson,
+	                unsigned tournament_size=2,
+	                double ucb_quantile=0.95);
+
+	/**
+	 * Select an index according to the policy. Thompson and
+	 * SingleDrawThompson both perform a single draw here, as no
+	 * distribution is required.
+	 */
+	size_t operator()(RandGen& rng=randGen()) const;
+
+	/**
+	 * Select an index with single draw Thompson sampling, see
+	 * ThompsonSampling::operator().
+	 */
+	size_t thompson(RandGen& rng=randGen()) const;
+
+	/**
+	 * Select the index with the highest ucb_quantile of its
+	 * beta-distribution, ties are randomly broken.
+	 */
+	size_t bayes_ucb(RandGen& rng=randGen()) const;
+
+	/**
+	 * Draw tournament_size indices uniformly at random (with
+	 * replacement) and select the one with the highest mean.
+	 */
+	size_t tournament(RandGen& rng=randGen()) const;
+
+	std::string to_string(const std::string& indent=empty_string) const;
+
+private:
+	const TruthValueSeq& _tvs;
+	SelectionPolicy _policy;
+	unsigned _tournament_size;
+	double _ucb_quantile;
+};
+
+/**
+ * Return the policy corresponding to a parameter value, throw an
+ * exception if it doesn't correspond to any.
+ */
+SelectionPolicy to_selection_policy(int value);
+
+// Debugging helpers see
+// http://wiki.opencog.org/w/Development_standards#Print_OpenCog_Objects
+// The reason indent is not an optional argument with default is
+// because gdb doesn't support that, see
+// http://stackoverflow.com/questions/16734783 for more explanation.
+std::string oc_to_string(SelectionPolicy policy,
+                         const std::string& indent=empty_string);
+std::string oc_to_string(const PolicySelection& psel,
+                         const std::string& indent=empty_string);
+
+} // namespace opencog
+
+#endif /* _OPENCOG_SELECTION_POLICY_H_ */
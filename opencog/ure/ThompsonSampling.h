@@ -72,11 +72,9 @@ public:
 
 	/**
 	 * Perform random action selection according to the action
+	 * distribution, by drawing a first order probability per TV and
+	 * picking the maximum, without building the selection
 	 * distribution.
-	 *
-	 * TODO: for now it builds the entire selection distribution, then
-	 * select the index accordingly. This could be greatly optimized by
-	 * sampling on the fly without building it.
 	 */
 	size_t operator()(RandGen& rng=randGen()) const;
 
@@ -41,16 +41,34 @@ const std::string UREConfig::jobs_name =
 	"URE:jobs";
 const std::string UREConfig::expansion_pool_size_name =
 	"URE:expansion-pool-size";
+const std::string UREConfig::selection_policy_name =
+	"URE:selection-policy";
+const std::string UREConfig::tournament_size_name =
+	"URE:tournament-size";
+const std::string UREConfig::unification_cache_size_name =
+	"URE:unification-cache-size";
+const std::string UREConfig::phase_timing_name =
+	"URE:phase-timing";
 const std::string UREConfig::fc_retry_exhausted_sources_name =
 	"URE:FC:retry-exhausted-sources";
 const std::string UREConfig::fc_full_rule_application_name =
 	"URE:FC:full-rule-application";
+const std::string UREConfig::fc_semi_naive_rule_application_name =
+	"URE:FC:semi-naive-rule-application";
+const std::string UREConfig::fc_rete_rule_application_name =
+	"URE:FC:rete-rule-application";
+const std::string UREConfig::fc_max_expansion_pool_size_name =
+	"URE:FC:maximum-expansion-pool-size";
+const std::string UREConfig::fc_max_inference_records_name =
+	"URE:FC:maximum-inference-records";
 const std::string UREConfig::bc_max_bit_size_name =
 	"URE:BC:maximum-bit-size";
 const std::string UREConfig::bc_mm_complexity_penalty_name =
 	"URE:BC:MM:complexity-penalty";
 const std::string UREConfig::bc_mm_compressiveness_name =
 	"URE:BC:MM:compressiveness";
+const std::string UREConfig::bc_online_action_statistics_name =
+	"URE:BC:online-action-statistics";
 
 UREConfig::UREConfig(AtomSpace& as, const Handle& rbs) : _as(as)
 {
@@ -93,6 +111,26 @@ int UREConfig::get_expansion_pool_size() const
 	return _common_params.expansion_pool_size;
 }
 
+SelectionPolicy UREConfig::get_selection_policy() const
+{
+	return _common_params.selection_policy;
+}
+
+unsigned UREConfig::get_tournament_size() const
+{
+	return _common_params.tournament_size;
+}
+
+int UREConfig::get_unification_cache_size() const
+{
+	return _common_params.unification_cache_size;
+}
+
+bool UREConfig::get_phase_timing() const
+{
+	return _common_params.phase_timing;
+}
+
 bool UREConfig::get_retry_exhausted_sources() const
 {
 	return _fc_params.retry_exhausted_sources;
@@ -103,6 +141,26 @@ bool UREConfig::get_full_rule_application() const
 	return _fc_params.full_rule_application;
 }
 
+bool UREConfig::get_semi_naive_rule_application() const
+{
+	return _fc_params.semi_naive_rule_application;
+}
+
+bool UREConfig::get_rete_rule_application() const
+{
+	return _fc_params.rete_rule_application;
+}
+
+int UREConfig::get_max_expansion_pool_size() const
+{
+	return _fc_params.max_expansion_pool_size;
+}
+
+int UREConfig::get_max_inference_records() const
+{
+	return _fc_params.max_inference_records;
+}
+
 double UREConfig::get_max_bit_size() const
 {
 	return _bc_params.max_bit_size;
@@ -118,6 +176,11 @@ double UREConfig::get_mm_compressiveness() const
 	return _bc_params.mm_compressiveness;
 }
 
+bool UREConfig::get_online_action_statistics() const
+{
+	return _bc_params.online_action_statistics;
+}
+
 std::string UREConfig::get_maximum_iterations_str() const
 {
 	if (_common_params.max_iter < 0)
@@ -145,6 +208,26 @@ void UREConfig::set_expansion_pool_size(int eps)
 	_common_params.expansion_pool_size = eps;
 }
 
+void UREConfig::set_selection_policy(SelectionPolicy sp)
+{
+	_common_params.selection_policy = sp;
+}
+
+void UREConfig::set_tournament_size(unsigned ts)
+{
+	_common_params.tournament_size = ts;
+}
+
+void UREConfig::set_unification_cache_size(int ucs)
+{
+	_common_params.unification_cache_size = ucs;
+}
+
+void UREConfig::set_phase_timing(bool pt)
+{
+	_common_params.phase_timing = pt;
+}
+
 void UREConfig::set_retry_exhausted_sources(bool rs)
 {
 	_fc_params.retry_exhausted_sources = rs;
@@ -155,6 +238,26 @@ void UREConfig::set_full_rule_application(bool rs)
 	_fc_params.full_rule_application = rs;
 }
 
+void UREConfig::set_semi_naive_rule_application(bool snra)
+{
+	_fc_params.semi_naive_rule_application = snra;
+}
+
+void UREConfig::set_rete_rule_application(bool rra)
+{
+	_fc_params.rete_rule_application = rra;
+}
+
+void UREConfig::set_max_expansion_pool_size(int meps)
+{
+	_fc_params.max_expansion_pool_size = meps;
+}
+
+void UREConfig::set_max_inference_records(int mir)
+{
+	_fc_params.max_inference_records = mir;
+}
+
 void UREConfig::set_mm_complexity_penalty(double mm_cp)
 {
 	_bc_params.mm_complexity_penalty = mm_cp;
@@ -165,6 +268,11 @@ void UREConfig::set_mm_compressiveness(double mm_cpr)
 	_bc_params.mm_complexity_penalty = mm_cpr;
 }
 
+void UREConfig::set_online_action_statistics(bool oas)
+{
+	_bc_params.online_action_statistics = oas;
+}
+
 HandleSeq UREConfig::fetch_rule_names(const Handle& rbs)
 {
 	// Retrieve rules
@@ -209,6 +317,23 @@ void UREConfig::fetch_common_parameters(const Handle& rbs)
 	// Fetch production application ratio
 	_common_params.expansion_pool_size =
 		fetch_num_param(expansion_pool_size_name, rbs, 1);
+
+	// Fetch selection policy
+	_common_params.selection_policy = to_selection_policy(
+		fetch_num_param(selection_policy_name, rbs,
+		                (int)SelectionPolicy::Thompson));
+
+	// Fetch tournament size
+	_common_params.tournament_size =
+		std::max(1.0, fetch_num_param(tournament_size_name, rbs, 2));
+
+	// Fetch unification cache size
+	_common_params.unification_cache_size =
+		fetch_num_param(unification_cache_size_name, rbs, 0);
+
+	// Fetch phase timing parameter
+	_common_params.phase_timing =
+		fetch_bool_param(phase_timing_name, rbs, false);
 }
 
 void UREConfig::fetch_fc_parameters(const Handle& rbs)
@@ -218,6 +343,14 @@ void UREConfig::fetch_fc_parameters(const Handle& rbs)
 		fetch_bool_param(fc_retry_exhausted_sources_name, rbs, false);
 	_fc_params.full_rule_application =
 		fetch_bool_param(fc_full_rule_application_name, rbs, false);
+	_fc_params.semi_naive_rule_application =
+		fetch_bool_param(fc_semi_naive_rule_application_name, rbs, false);
+	_fc_params.rete_rule_application =
+		fetch_bool_param(fc_rete_rule_application_name, rbs, false);
+	_fc_params.max_expansion_pool_size =
+		fetch_num_param(fc_max_expansion_pool_size_name, rbs, -1);
+	_fc_params.max_inference_records =
+		fetch_num_param(fc_max_inference_records_name, rbs, -1);
 }
 
 void UREConfig::fetch_bc_parameters(const Handle& rbs)
@@ -232,6 +365,10 @@ void UREConfig::fetch_bc_parameters(const Handle& rbs)
 	// Fetch BC Mixture Model compressiveness parameter
 	_bc_params.mm_compressiveness =
 		fetch_num_param(bc_mm_compressiveness_name, rbs, 1);
+
+	// Fetch BC online action statistics parameter
+	_bc_params.online_action_statistics =
+		fetch_bool_param(bc_online_action_statistics_name, rbs, false);
 }
 
 HandleSeq UREConfig::fetch_execution_outputs(const Handle& schema,
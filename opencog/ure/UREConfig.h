@@ -25,6 +25,7 @@
 #define _OPENCOG_URE_CONFIG_H
 
 #include "Rule.h"
+#include "SelectionPolicy.h"
 
 #include <opencog/atomspace/AtomSpace.h>
 
@@ -64,13 +65,22 @@ public:
 	double get_complexity_penalty() const;
 	int get_jobs() const;
 	int get_expansion_pool_size() const;
+	SelectionPolicy get_selection_policy() const;
+	unsigned get_tournament_size() const;
+	int get_unification_cache_size() const;
+	bool get_phase_timing() const;
 	// FC
 	bool get_retry_exhausted_sources() const;
 	bool get_full_rule_application() const;
+	bool get_semi_naive_rule_application() const;
+	bool get_rete_rule_application() const;
+	int get_max_expansion_pool_size() const;
+	int get_max_inference_records() const;
 	// BC
 	double get_max_bit_size() const;
 	double get_mm_complexity_penalty() const;
 	double get_mm_compressiveness() const;
+	bool get_online_action_statistics() const;
 
 	// Display
 	std::string get_maximum_iterations_str() const; // "+inf" if negative
@@ -85,12 +95,21 @@ public:
 	void set_complexity_penalty(double);
 	void set_jobs(int);
 	void set_expansion_pool_size(int);
+	void set_selection_policy(SelectionPolicy);
+	void set_tournament_size(unsigned);
+	void set_unification_cache_size(int);
+	void set_phase_timing(bool);
 	// FC
 	void set_retry_exhausted_sources(bool);
 	void set_full_rule_application(bool);
+	void set_semi_naive_rule_application(bool);
+	void set_rete_rule_application(bool);
+	void set_max_expansion_pool_size(int);
+	void set_max_inference_records(int);
 	// BC
 	void set_mm_complexity_penalty(double);
 	void set_mm_compressiveness(double);
+	void set_online_action_statistics(bool);
 
 	//////////////////
 	// Constants    //
@@ -114,6 +133,19 @@ public:
 	// Name of the production application ratio parameter
 	static const std::string expansion_pool_size_name;
 
+	// Name of the selection policy parameter
+	static const std::string selection_policy_name;
+
+	// Name of the tournament size parameter
+	static const std::string tournament_size_name;
+
+	// Name of the unification cache size parameter
+	static const std::string unification_cache_size_name;
+
+	// Name of the PredicateNode outputting whether the time spent in
+	// each phase of the chainers should be measured
+	static const std::string phase_timing_name;
+
 	// Name of the PredicateNode outputting whether sources should be
 	// retried after exhaustion
 	static const std::string fc_retry_exhausted_sources_name;
@@ -123,6 +155,24 @@ public:
 	// source.
 	static const std::string fc_full_rule_application_name;
 
+	// Name of the PredicateNode outputting whether a rule applied
+	// over the entire atomspace should only be matched against the
+	// atoms derived since its last application.
+	static const std::string fc_semi_naive_rule_application_name;
+
+	// Name of the PredicateNode outputting whether rules applied over
+	// the entire atomspace should be matched incrementally by a
+	// Rete-style network.
+	static const std::string fc_rete_rule_application_name;
+
+	// Name of the maximum number of (source, rule) pairs in the
+	// expansion pool parameter
+	static const std::string fc_max_expansion_pool_size_name;
+
+	// Name of the maximum number of inference records retained in
+	// memory parameter
+	static const std::string fc_max_inference_records_name;
+
 	// Name of the maximum number of and-BITs in the BIT parameter
 	static const std::string bc_max_bit_size_name;
 
@@ -134,6 +184,11 @@ public:
 	// much unexplained data are compressed
 	static const std::string bc_mm_compressiveness_name;
 
+	// Name of the PredicateNode outputting whether the success
+	// counts of the rule aliases gathered during backward chaining
+	// should be used for rule selection
+	static const std::string bc_online_action_statistics_name;
+
 private:
 	AtomSpace& _as;
 
@@ -160,6 +215,26 @@ private:
 		// iterative forward chainer), but also then the selection is
 		// more costly. Negative means unlimited.
 		int expansion_pool_size;
+
+		// This parameter controls how actions (inference rules in
+		// the backward chainer, source rule pairs and rules in the
+		// forward chainer) are selected, see SelectionPolicy for the
+		// possible values. Thompson sampling by default, the others
+		// are cheaper alternatives.
+		SelectionPolicy selection_policy;
+
+		// Number of contenders when the selection policy is
+		// tournament selection.
+		unsigned tournament_size;
+
+		// Maximum number of unification results cached across
+		// chainer steps, see UnifyCache. Each chainer owns its cache.
+		// 0 or negative disables it.
+		int unification_cache_size;
+
+		// Measure the time spent in each phase of the chainers, see
+		// PhaseTimers. Disabled by default.
+		bool phase_timing;
 	};
 	CommonParameters _common_params;
 
@@ -171,6 +246,34 @@ private:
 		// Apply the selected rule over the entire atomspace, not just
 		// the selected source.
 		bool full_rule_application;
+
+		// When full_rule_application is enabled, only apply a rule
+		// over groundings involving at least one atom derived since
+		// its last application (semi-naive evaluation), instead of
+		// re-deriving everything at each application.
+		bool semi_naive_rule_application;
+
+		// When full_rule_application is enabled, compile the rules
+		// into a Rete-style network (see RuleNetwork), fed by the
+		// derived atoms, so that each application of a rule only
+		// produces its new matches. Takes precedence over
+		// semi_naive_rule_application.
+		bool rete_rule_application;
+
+		// This put an upper boundary on the number of (source, rule)
+		// pairs the expansion pool can hold, the least promising ones
+		// being set aside in an overflow beyond it, to be re-admitted
+		// when room is made or when they outrank the pairs of the
+		// pool, without being produced again. Useful to keep
+		// selection cheap when expansion_pool_size is
+		// unlimited. Negative means unlimited.
+		int max_expansion_pool_size;
+
+		// Maximum number of inference records retained in memory, the
+		// oldest being discarded beyond it. Zero means only counts
+		// are retained, negative means the full trace is. The union
+		// of all products is retained regardless.
+		int max_inference_records;
 };
 	FCParameters _fc_params;
 
@@ -191,6 +294,12 @@ private:
 		// unexplained data are compressed. The compressed unexplained
 		// data are added to the model complexity.
 		double mm_compressiveness;
+
+		// Use the success counts of each rule alias, gathered from
+		// the proofs found so far (and possibly loaded from previous
+		// sessions), in addition to their default TVs, to select
+		// rules for expansion.
+		bool online_action_statistics;
 	};
 	BCParameters _bc_params;
 
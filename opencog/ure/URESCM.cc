@@ -24,6 +24,8 @@
 #ifdef HAVE_GUILE
 
 #include <opencog/ure/URELogger.h>
+#include <opencog/ure/PhaseTimers.h>
+#include <opencog/ure/ChainerStats.h>
 #include <opencog/guile/SchemeModule.h>
 
 namespace opencog {
@@ -45,15 +47,29 @@ protected:
 	 *                     chaining will be applied.  If the set link is
 	 *                     empty, chaining will be invoked on the entire
 	 *                     atomspace.
+	 * @param product_callback A grounded schema executed over a SetLink
+	 *                     of the products of each rule application, as
+	 *                     soon as they are derived. A ListLink means no
+	 *                     callback.
+	 * @param results_set  Whether to return a SetLink of all results.
+	 * @param chainer_stats Whether to attach the chainer statistics
+	 *                     to rbs, see set_chainer_stats.
 	 *
-	 * @return             A SetLink containing the results of FC inference.
+	 * @return             A SetLink containing the results of FC
+	 *                     inference, or the undefined handle if
+	 *                     results_set is false. If URE:phase-timing is
+	 *                     enabled, the time spent in each phase is
+	 *                     attached to rbs, see set_phase_times.
 	 */
 	Handle do_forward_chaining(Handle rbs,
 	                           Handle source,
 	                           Handle vardecl,
 	                           bool trace_enabled,
 	                           AtomSpace *trace_as,
-	                           Handle focus_set);
+	                           Handle focus_set,
+	                           Handle product_callback,
+	                           bool results_set,
+	                           bool chainer_stats);
 
 	/**
 	 * The scheme (cog-mandatory-args-bc) function calls this, to
@@ -68,8 +84,19 @@ protected:
 	 *                     chaining will be applied.  If the set link is
 	 *                     empty, chaining will be invoked on the entire
 	 *                     atomspace.
+	 * @param load_action_stats File from which to load the action
+	 *                     statistics before chaining, see
+	 *                     ActionStatistics::load. Empty means none.
+	 * @param save_action_stats File where to save the action
+	 *                     statistics after chaining, see
+	 *                     ActionStatistics::save. Empty means none.
+	 * @param chainer_stats Whether to attach the chainer statistics
+	 *                     to rbs, see set_chainer_stats.
 	 *
-	 * @return             A SetLink containing the results of FC inference.
+	 * @return             A SetLink containing the results of BC
+	 *                     inference. If URE:phase-timing is enabled,
+	 *                     the time spent in each phase is attached to
+	 *                     rbs, see set_phase_times.
 	 */
 	Handle do_backward_chaining(Handle rbs,
 	                            Handle target,
@@ -78,7 +105,10 @@ protected:
 	                            AtomSpace* trace_as,
 	                            bool control_enabled,
 	                            AtomSpace* control_as,
-	                            Handle focus_set);
+	                            Handle focus_set,
+	                            const std::string& load_action_stats,
+	                            const std::string& save_action_stats,
+	                            bool chainer_stats);
 
 	Handle get_rulebase_rules(Handle rbs);
 
@@ -87,6 +117,27 @@ protected:
 	 */
 	Logger* do_ure_logger();
 
+	/**
+	 * Attach the phase timings of a chainer, if enabled, to its rule
+	 * base, see PhaseTimers::to_value, replacing the ones of the
+	 * previous call with that rule base, if any. Unlike the results,
+	 * which are shared by all calls producing the same atoms, the rule
+	 * base is specific to the call, and is available whether the
+	 * results are returned or not. If disabled, the timings of the
+	 * previous call are removed, so that they are not mistaken for
+	 * the ones of this call.
+	 */
+	void set_phase_times(AtomSpace* as, const Handle& rbs,
+	                     const PhaseTimers& pt);
+
+	/**
+	 * Attach the statistics of a chainer, if enabled, to its rule
+	 * base, see ChainerStats::to_value, like set_phase_times. If
+	 * disabled, the statistics of the previous call are removed.
+	 */
+	void set_chainer_stats(AtomSpace* as, const Handle& rbs,
+	                       const ChainerStats& cs, bool enabled);
+
 public:
 	URESCM();
 };
@@ -123,7 +174,10 @@ Handle URESCM::do_forward_chaining(Handle rbs,
                                    Handle vardecl,
                                    bool trace_enabled,
                                    AtomSpace *trace_as,
-                                   Handle focus_set_h)
+                                   Handle focus_set_h,
+                                   Handle product_callback,
+                                   bool results_set,
+                                   bool chainer_stats)
 {
 	AtomSpace *as = SchemeSmob::ss_get_env_as("cog-mandatory-args-fc");
 	HandleSeq focus_set = {};
@@ -143,7 +197,15 @@ Handle URESCM::do_forward_chaining(Handle rbs,
 			"URESCM::do_forward_chaining - focus set should be SET_LINK type!");
 
 	ForwardChainer fc(*as, rbs, source, vardecl, trace_as, focus_set);
+	// A ListLink means that there is no product callback
+	if (product_callback->get_type() != LIST_LINK)
+		fc.set_product_callback(product_callback);
 	fc.do_chain();
+	set_phase_times(as, rbs, fc.get_phase_timers());
+	set_chainer_stats(as, rbs, fc.get_stats(), chainer_stats);
+	if (not results_set)
+		return Handle::UNDEFINED;
+
 	return fc.get_results();
 }
 
@@ -154,7 +216,10 @@ Handle URESCM::do_backward_chaining(Handle rbs,
                                     AtomSpace *trace_as,
                                     bool control_enabled,
                                     AtomSpace *control_as,
-                                    Handle focus_link)
+                                    Handle focus_link,
+                                    const std::string& load_action_stats,
+                                    const std::string& save_action_stats,
+                                    bool chainer_stats)
 {
 	// A ListLink means that the variable declaration is undefined
 	if (vardecl->get_type() == LIST_LINK)
@@ -169,8 +234,16 @@ Handle URESCM::do_backward_chaining(Handle rbs,
 	AtomSpace *as = SchemeSmob::ss_get_env_as("cog-mandatory-args-bc");
 	BackwardChainer bc(*as, rbs, target, vardecl, trace_as, control_as, focus_link);
 
+	if (not load_action_stats.empty())
+		bc.get_action_statistics().load(load_action_stats, *as);
+
 	bc.do_chain();
 
+	if (not save_action_stats.empty())
+		bc.get_action_statistics().save(save_action_stats);
+
+	set_phase_times(as, rbs, bc.get_phase_timers());
+	set_chainer_stats(as, rbs, bc.get_stats(), chainer_stats);
 	return bc.get_results();
 }
 
@@ -179,6 +252,24 @@ Logger* URESCM::do_ure_logger()
 	return &ure_logger();
 }
 
+void URESCM::set_phase_times(AtomSpace* as, const Handle& rbs,
+                             const PhaseTimers& pt)
+{
+	Handle key = as->add_node(PREDICATE_NODE,
+	                          std::string(PhaseTimers::key_name));
+	// A null value removes the key
+	rbs->setValue(key, pt.is_enabled() ? pt.to_value() : nullptr);
+}
+
+void URESCM::set_chainer_stats(AtomSpace* as, const Handle& rbs,
+                               const ChainerStats& cs, bool enabled)
+{
+	Handle key = as->add_node(PREDICATE_NODE,
+	                          std::string(ChainerStats::key_name));
+	// A null value removes the key
+	rbs->setValue(key, enabled ? cs.to_value() : nullptr);
+}
+
 extern "C" {
 void opencog_ure_init(void);
 };
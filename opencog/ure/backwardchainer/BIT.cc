@@ -331,11 +331,14 @@ Handle AndBIT::expand_fcs(const Handle& leaf,
 	Handle nfcs_rewrite = nfcs_bl->get_implicand()[0]; // assume that there is only one
 	Handle rule_vardecl = rule.first.get_vardecl();
 
+	// Build the full rule from its view, only needed here
+	Rule full_rule = rule.first.to_rule();
+
 	// Generate new pattern term
-	Handle npattern = expand_fcs_pattern(nfcs_pattern, rule.first);
+	Handle npattern = expand_fcs_pattern(nfcs_pattern, full_rule);
 
 	// Generate new rewrite term
-	Handle nrewrite = expand_fcs_rewrite(nfcs_rewrite, rule.first);
+	Handle nrewrite = expand_fcs_rewrite(nfcs_rewrite, full_rule);
 
 	// Generate new vardecl
 	// TODO: is this merging necessary?
@@ -826,12 +829,15 @@ AndBIT* BIT::init()
 }
 
 AndBIT* BIT::expand(AndBIT& andbit, BITNode& bitleaf,
-                    const RuleTypedSubstitutionPair& rule, double prob)
+                    const RuleTypedSubstitutionPair& rule, double prob,
+                    ChainerStats* stats)
 {
 	// Make sure that the rule is not already an or-child of bitleaf.
 	if (contains(bitleaf, rule)) {
 		ure_logger().debug() << "An equivalent rule has already expanded "
 		                     << "that BIT-node, abort expansion";
+		if (stats)
+			stats->add(ChainerStats::ANDBITS_REJECTED_DUPLICATE);
 		return nullptr;
 	}
 
@@ -839,9 +845,18 @@ AndBIT* BIT::expand(AndBIT& andbit, BITNode& bitleaf,
 	bitleaf.rules.insert(rule);
 
 	// Expand the and-BIT and insert it in the BIT, if the expansion
-	// was successful
+	// was successful. An expansion only fails if it has a cycle, or
+	// is equal to the expanded and-BIT, which is a degenerate cycle.
 	AndBIT new_andbit = andbit.expand(bitleaf.body, rule, prob);
-	return (bool)new_andbit.fcs ? insert(new_andbit) : nullptr;
+	if (not new_andbit.fcs) {
+		if (stats)
+			stats->add(ChainerStats::ANDBITS_REJECTED_CYCLE);
+		return nullptr;
+	}
+	AndBIT* inserted = insert(new_andbit);
+	if (not inserted and stats)
+		stats->add(ChainerStats::ANDBITS_REJECTED_DUPLICATE);
+	return inserted;
 }
 
 AndBIT* BIT::insert(AndBIT& andbit)
@@ -28,6 +28,7 @@
 #include <opencog/util/empty_string.h>
 #include <opencog/ure/Rule.h>
 #include <opencog/ure/Utils.h>
+#include <opencog/ure/ChainerStats.h>
 #include <opencog/atoms/base/Handle.h>
 #include "Fitness.h"
 
@@ -475,10 +476,14 @@ public:
 	 * andbit and bitleaf are not passed by const because bitleaf
 	 * keeps a record of that expansion and is this modified during
 	 * that step.
+	 *
+	 * If stats is provided, the cause of a failed expansion is
+	 * counted in it, see ChainerStats::ANDBITS_REJECTED_CYCLE and
+	 * ChainerStats::ANDBITS_REJECTED_DUPLICATE.
 	 */
 	AndBIT* expand(AndBIT& andbit, BITNode& bitleaf,
 	               const RuleTypedSubstitutionPair& rule,
-	               double prob=1.0);
+	               double prob=1.0, ChainerStats* stats=nullptr);
 
 	/**
 	 * Insert a new andbit in the BIT and return its pointer, nullptr
@@ -26,6 +26,7 @@
 #include <opencog/util/random.h>
 
 #include <opencog/unify/Unify.h>
+#include <opencog/unify/UnifyCache.h>
 
 #include "BackwardChainer.h"
 #include "../URELogger.h"
@@ -49,8 +50,9 @@ BackwardChainer::BackwardChainer(AtomSpace& kb_as,
 	  _config(_rb_as, rbs),
 	  _bit(kb_as, target, vardecl, bitnode_fitness),
 	  _andbit_fitness(andbit_fitness),
-	  _trace_recorder(trace_as),
-	  _control(_config, _bit, target, control_as),
+	  _trace_recorder(trace_as, nullptr, &_stats),
+	  _control(_config, _bit, target, control_as, &_action_stats, &_stats,
+	           &_unify_cache),
 	  _rules(_control.rules),
 	  _iteration(0),
 	  _last_expansion_andbit(nullptr)
@@ -90,11 +92,33 @@ void BackwardChainer::do_chain()
 	ure_logger().debug("Start backward chaining");
 	LAZY_URE_LOG_DEBUG << "With rule set:" << std::endl << oc_to_string(_rules);
 
+	_unify_cache.set_max_size(std::max(0, _config.get_unification_cache_size()));
+	size_t unify_cache_hits = _unify_cache.get_hits(),
+		unify_cache_misses = _unify_cache.get_misses();
+	_phase_timers.clear();
+	_phase_timers.set_enabled(_config.get_phase_timing());
+	_stats.clear();
+	// Only feed the action statistics if they are used, otherwise
+	// the expansion origins would grow for nothing
+	_trace_recorder.set_action_statistics(
+		_config.get_online_action_statistics() ? &_action_stats : nullptr);
+
 	while (not termination())
 	{
 		do_step();
 	}
 
+	_stats.set(ChainerStats::UNIFY_CACHE_HITS,
+	           _unify_cache.get_hits() - unify_cache_hits);
+	_stats.set(ChainerStats::UNIFY_CACHE_MISSES,
+	           _unify_cache.get_misses() - unify_cache_misses);
+	LAZY_URE_LOG_DEBUG << "Unification cache: " << oc_to_string(_unify_cache);
+	if (_phase_timers.is_enabled())
+		LAZY_URE_LOG_DEBUG << "Phase timers:" << std::endl
+		                   << oc_to_string(_phase_timers);
+	LAZY_URE_LOG_DEBUG << "Chainer statistics:" << std::endl
+	                   << oc_to_string(_stats);
+
 	LAZY_URE_LOG_DEBUG << "Finished backward chaining with results:"
 	                   << std::endl << oc_to_string(get_results_set());
 }
@@ -142,8 +166,35 @@ const HandleSet& BackwardChainer::get_results_set() const
 	return _results;
 }
 
+int BackwardChainer::get_iteration() const
+{
+	return _iteration;
+}
+
+const PhaseTimers& BackwardChainer::get_phase_timers() const
+{
+	return _phase_timers;
+}
+
+const ChainerStats& BackwardChainer::get_stats() const
+{
+	return _stats;
+}
+
+ActionStatistics& BackwardChainer::get_action_statistics()
+{
+	return _action_stats;
+}
+
+const ActionStatistics& BackwardChainer::get_action_statistics() const
+{
+	return _action_stats;
+}
+
 void BackwardChainer::expand_meta_rules()
 {
+	PhaseTimers::Scope scope(_phase_timers, "expand_meta_rules");
+
 	// This is kinda of hack before meta rules are fully supported by
 	// the Rule class.
 	size_t rules_size = _rules.size();
@@ -161,6 +212,8 @@ void BackwardChainer::expand_meta_rules()
 
 void BackwardChainer::expand_bit()
 {
+	PhaseTimers::Scope scope(_phase_timers, "expand_bit");
+
 	// Expand meta rules, before they are fully supported
 	expand_meta_rules();
 
@@ -195,15 +248,13 @@ void BackwardChainer::expand_bit(AndBIT& andbit)
 	}
 
 	// Select rule for expansion
-	RuleSelection rule_sel = _control.select_rule(andbit, *bitleaf);
-	Rule rule(rule_sel.first.first);
-	Unify::TypedSubstitution ts(rule_sel.first.second);
+	RuleSelection rule_sel = [&]() {
+		PhaseTimers::Scope scope(_phase_timers, "select_rule");
+		return _control.select_rule(andbit, *bitleaf);
+	}();
+	Rule rule = rule_sel.first.first.to_rule();
 	double prob(rule_sel.second);
 
-	// Add the rule in the _bit.bit_as to make comparing atoms easier
-	// as well as logging more consistent.
-	rule.add(_bit.bit_as);
-
 	// Abort expansion if ill rule
 	if (not rule.is_valid()) {
 		ure_logger().debug("No valid rule for the selected BIT-node, "
@@ -213,6 +264,7 @@ void BackwardChainer::expand_bit(AndBIT& andbit)
 		LAZY_URE_LOG_DEBUG << "The following rule has cycle (some premise "
 		                   << "equals to conclusion), abort expansion:"
 		                   << std::endl << rule.to_string();
+		_stats.add(ChainerStats::ANDBITS_REJECTED_CYCLE);
 		return;
 	}
 
@@ -226,8 +278,8 @@ void BackwardChainer::expand_bit(AndBIT& andbit)
 	// bodies for future use.
 	Handle andbit_fcs = andbit.fcs;
 	Handle bitleaf_body = bitleaf->body;
-	RuleTypedSubstitutionPair rtsp{rule, ts};
-	_last_expansion_andbit = _bit.expand(andbit, *bitleaf, rtsp, prob);
+	_last_expansion_andbit = _bit.expand(andbit, *bitleaf, rule_sel.first,
+	                                     prob, &_stats);
 
 	// Record the expansion in the trace atomspace
 	if (_last_expansion_andbit) {
@@ -258,11 +310,16 @@ void BackwardChainer::fulfill_bit()
 	// it.
 	try {
 		fulfill_fcs(andbit->fcs);
-	} catch (...) {}
+	} catch (...) {
+		_stats.add(ChainerStats::FCS_FULFILLMENTS_FAILED);
+	}
 }
 
 void BackwardChainer::fulfill_fcs(const Handle& fcs)
 {
+	PhaseTimers::Scope scope(_phase_timers, "fulfill_fcs");
+	_stats.add(ChainerStats::FCS_FULFILLMENTS);
+
 	// Temporary atomspace to not pollute _as with intermediary
 	// results
 	AtomSpacePtr tmp_as(createAtomSpace(&_kb_as));
@@ -328,6 +385,8 @@ const AndBIT* BackwardChainer::select_fulfillment_andbit() const
 
 void BackwardChainer::reduce_bit()
 {
+	PhaseTimers::Scope scope(_phase_timers, "reduce_bit");
+
 	if (0 < _config.get_max_bit_size()) {
 		// If the BIT size has reached its maximum, randomly remove
 		// and-BITs so that the BIT size gets back below or equal to
@@ -381,6 +440,7 @@ void BackwardChainer::remove_unlikely_expandable_andbit()
 	LAZY_URE_LOG_DEBUG << "Remove " << it->fcs->id_to_string()
 	                   << " from the BIT";
 	_bit.erase(it);
+	_stats.add(ChainerStats::ANDBITS_PRUNED);
 }
 
 double BackwardChainer::complexity_factor(const AndBIT& andbit) const
@@ -27,6 +27,9 @@
 
 #include "../Rule.h"
 #include "../UREConfig.h"
+#include "../ActionStatistics.h"
+#include "../PhaseTimers.h"
+#include "../ChainerStats.h"
 #include "BIT.h"
 #include "TraceRecorder.h"
 #include "ControlPolicy.h"
@@ -171,6 +174,34 @@ public:
 	Handle get_results() const;
 	const HandleSet& get_results_set() const;
 
+	/**
+	 * Get the number of iterations performed so far.
+	 */
+	int get_iteration() const;
+
+	/**
+	 * Get the time spent in each phase of the last call of do_chain,
+	 * if URE:phase-timing is enabled. The phases are expand_bit,
+	 * expand_meta_rules, select_rule, fulfill_fcs and reduce_bit.
+	 */
+	const PhaseTimers& get_phase_timers() const;
+
+	/**
+	 * Get the counts of unifications, and-BITs and FCS fulfillments
+	 * of the last call of do_chain, see ChainerStats.
+	 */
+	const ChainerStats& get_stats() const;
+
+	/**
+	 * Success counts of the rule aliases, updated as proofs are
+	 * found, if the URE:BC:online-action-statistics parameter is
+	 * enabled, in which case they are also used for rule
+	 * selection. They can be saved at the end of a reasoning session,
+	 * and loaded before do_chain to warm start the next one.
+	 */
+	ActionStatistics& get_action_statistics();
+	const ActionStatistics& get_action_statistics() const;
+
 private:
 	void expand_meta_rules();
 
@@ -231,9 +262,19 @@ private:
 	// TODO: perhaps move that under BIT
 	AndBITFitness _andbit_fitness;
 
+	// Success counts of the rule aliases
+	ActionStatistics _action_stats;
+
+	// Counts of unifications, and-BITs and FCS fulfillments
+	ChainerStats _stats;
+
 	// In charge of recording the inference traces
 	TraceRecorder _trace_recorder;
 
+	// Cache of the unifications of the BIT-nodes against the rules,
+	// sized by the unification-cache-size parameter.
+	UnifyCache _unify_cache;
+
 	// Inference Control Policy. Determine how to expand the BIT.
 	ControlPolicy _control;
 
@@ -242,6 +283,9 @@ private:
 
 	int _iteration;
 
+	// Time spent in each phase
+	PhaseTimers _phase_timers;
+
 	// Keep track of the and-BIT of the last expansion. Null if the
 	// last expansion has failed.
 	const AndBIT* _last_expansion_andbit;
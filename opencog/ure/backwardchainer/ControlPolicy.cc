@@ -37,13 +37,14 @@
 
 using namespace opencog;
 
-#define al _query_as->add_link
-#define an _query_as->add_node
-
 ControlPolicy::ControlPolicy(const UREConfig& ure_config, const BIT& bit,
-                             const Handle& target, AtomSpace* control_as) :
+                             const Handle& target, AtomSpace* control_as,
+                             const ActionStatistics* action_stats,
+                             ChainerStats* stats,
+                             UnifyCache* unify_cache) :
 	rules(ure_config.get_rules()), _ure_config(ure_config),
-	_bit(bit), _target(target), _control_as(control_as), _query_as(nullptr)
+	_bit(bit), _target(target), _action_stats(action_stats),
+	_stats(stats), _unify_cache(unify_cache), _control_as(control_as)
 {
 	// Fetch default TVs for each inference rule (the TV on the member
 	// link connecting the rule to the rule base)
@@ -56,17 +57,12 @@ ControlPolicy::ControlPolicy(const UREConfig& ure_config, const BIT& bit,
 		ss << std::endl << rtv.second->to_string() << " " << oc_to_string(rtv.first);
 	ure_logger().debug() << ss.str();
 
-	// Fetches expansion control rules from _control_as
+	// Fetches expansion control rules from _control_as, unless
+	// already fetched by another control policy
 	if (_control_as) {
-		_query_as = createAtomSpace(_control_as);
-		for (const Handle& rule_alias : rules.aliases()) {
-			HandleSet exp_ctrl_rules = fetch_expansion_control_rules(rule_alias);
-			_expansion_control_rules[rule_alias] = exp_ctrl_rules;
-
-			ure_logger().debug() << "Expansion control rules for "
-			                     << rule_alias->to_string()
-			                     << oc_to_string(exp_ctrl_rules);
-		}
+		_ctrl_registry = ControlRuleRegistry::get(_control_as);
+		for (const Handle& rule_alias : rules.aliases())
+			_ctrl_registry->expansion_control_rules(rule_alias);
 	}
 }
 
@@ -103,6 +99,21 @@ HandleSet ControlPolicy::rule_aliases(const RuleTypedSubstitutionMap& rules)
 	return aliases;
 }
 
+bool ControlPolicy::add_control_rule(const Handle& ctrl_rule)
+{
+	if (!_control_as)
+		return false;
+	return _ctrl_registry->add_control_rule(ctrl_rule);
+}
+
+TruthValuePtr ControlPolicy::default_tv(const Handle& rule_alias)
+{
+	const TruthValuePtr& tv = _default_tvs[rule_alias];
+	if (_action_stats and _ure_config.get_online_action_statistics())
+		return _action_stats->tv(rule_alias, tv);
+	return tv;
+}
+
 RuleTypedSubstitutionMap ControlPolicy::get_valid_rules(const AndBIT& andbit,
                                                         const BITNode& bitleaf)
 {
@@ -123,7 +134,12 @@ RuleTypedSubstitutionMap ControlPolicy::get_valid_rules(const AndBIT& andbit,
 			vardecl = BindLinkCast(andbit.fcs)->get_vardecl();
 
 		RuleTypedSubstitutionMap unified_rules
-			= rule->unify_target(bitleaf.body, vardecl);
+			= rule->unify_target(bitleaf.body, vardecl, nullptr, _unify_cache);
+		if (_stats) {
+			_stats->add(ChainerStats::UNIFICATIONS_ATTEMPTED);
+			if (not unified_rules.empty())
+				_stats->add(ChainerStats::UNIFICATIONS_SUCCEEDED);
+		}
 
 		// Only insert unexplored rules for this leaf
 		RuleTypedSubstitutionMap pos_rules;
@@ -161,8 +177,12 @@ HandleTVMap ControlPolicy::expansion_success_tvs(
 	const RuleTypedSubstitutionMap& inf_rules)
 {
 	// For each rule alias, calculate the TV that selecting it will
-	// produce a preproof
+	// produce a preproof. Aliases with active control rules have
+	// their mixture models evaluated all at once.
 	HandleTVMap success_tvs;
+	HandleSeq mixed_aliases;
+	ModelSummarySeq summaries;
+	std::vector<size_t> offsets{0};
 	for (const auto& rule : rule_aliases(inf_rules)) {
 		// Get all active expansion control rules
 		HandleSet active_ctrl_rules =
@@ -171,16 +191,23 @@ HandleTVMap ControlPolicy::expansion_success_tvs(
 		if (active_ctrl_rules.empty()) {
 			// If there are no active control rules, use the default
 			// TV on the rule.
-			success_tvs[rule] = _default_tvs[rule];
+			success_tvs[rule] = default_tv(rule);
 		} else {
-			// Otherwise calculate the truth value of its mixture
-			// model.
-			double cpx_penalty = _ure_config.get_mm_complexity_penalty(),
-				compressiveness = _ure_config.get_mm_compressiveness();
-			success_tvs[rule] = MixtureModel(active_ctrl_rules,
-			                                 cpx_penalty, compressiveness)();
+			// Otherwise its TV is calculated by its mixture model.
+			mixed_aliases.push_back(rule);
+			for (const Handle& ctrl_rule : active_ctrl_rules)
+				summaries.push_back(_ctrl_registry->model_summary(ctrl_rule));
+			offsets.push_back(summaries.size());
 		}
 	}
+	if (not mixed_aliases.empty()) {
+		double cpx_penalty = _ure_config.get_mm_complexity_penalty(),
+			compressiveness = _ure_config.get_mm_compressiveness();
+		std::vector<TruthValuePtr> mixed_tvs =
+			MixtureModel::mix(summaries, offsets, cpx_penalty, compressiveness);
+		for (size_t i = 0; i < mixed_aliases.size(); i++)
+			success_tvs[mixed_aliases[i]] = mixed_tvs[i];
+	}
 
 	// Log TVs of representing probability of success (expanding into
 	// a preproof) for each action
@@ -198,9 +225,16 @@ std::vector<double> ControlPolicy::rule_weights(const HandleTVMap& success_tvs,
 {
 	// Given success_tvs calculate the action distribution over rule
 	// alias, as to (supposedly) optimally balance exploration and
-	// exploitation.
+	// exploitation. If a cheaper selection policy is used, directly
+	// select the rule alias instead, and give it all the weight.
 	ActionSelection action_selection(success_tvs);
-	HandleCounter alias_weights = action_selection.distribution();
+	HandleCounter alias_weights;
+	SelectionPolicy policy = _ure_config.get_selection_policy();
+	if (policy == SelectionPolicy::Thompson)
+		alias_weights = action_selection.distribution();
+	else
+		alias_weights[action_selection(policy,
+		                               _ure_config.get_tournament_size())] = 1.0;
 
 	// Log rule weights for action selection
 	std::stringstream ssw;
@@ -245,7 +279,9 @@ HandleSet ControlPolicy::active_expansion_control_rules(
 
 	// Filter out inactive expansion control rules
 	HandleSet results;
-	for (const Handle& ctrl_rule : _expansion_control_rules[inf_rule_alias])
+	ControlRuleSetPtr ctrl_rules =
+		_ctrl_registry->expansion_control_rules(inf_rule_alias);
+	for (const Handle& ctrl_rule : *ctrl_rules)
 		if (is_control_rule_active(andbit, bitleaf, ctrl_rule))
 			results.insert(ctrl_rule);
 
@@ -346,149 +382,20 @@ bool ControlPolicy::is_antecedent_preproof(const Handle& h) const
 
 Handle ControlPolicy::get_expansion(const Handle& ctrl_rule) const
 {
-	ScopeLinkPtr sc = ScopeLinkCast(ctrl_rule);
-	for (const Handle& h : sc->get_body()->getOutgoingSet())
-		if (is_expansion(h))
-			return h;
-	return Handle::UNDEFINED;
+	return ControlRuleRegistry::get_expansion(ctrl_rule);
 }
 
 bool ControlPolicy::is_expansion(const Handle& h) const
 {
-	if (h->get_type() == EXECUTION_LINK) {
-		Handle schema = h->getOutgoingAtom(0);
-		return schema->get_name() == TraceRecorder::expand_andbit_schema_name;
-	}
-	return false;
+	return ControlRuleRegistry::is_expansion(h);
 }
 
 HandleSet ControlPolicy::fetch_expansion_control_rules(const Handle& inf_rule)
 {
-	return set_union(fetch_expansion_control_rules(inf_rule, 0),
-	                 fetch_expansion_control_rules(inf_rule, 1));
-}
-
-HandleSet ControlPolicy::fetch_expansion_control_rules(const Handle& inf_rule,
-                                                       int n)
-{
-	Handle query = mk_expansion_control_rules_query(inf_rule, n);
-	Handle result = HandleCast(query->execute(_control_as));
-	HandleSeq outgoings(result->getOutgoingSet());
-	_control_as->remove_atom(result); // Remove cruft from _control_as
-	return HandleSet(outgoings.begin(), outgoings.end());
-}
-
-Handle ControlPolicy::mk_vardecl_vardecl(const Handle& vardecl_var)
-{
-	return al(TYPED_VARIABLE_LINK,
-	          vardecl_var,
-	          al(TYPE_CHOICE,
-	             an(TYPE_NODE, "VariableList"),
-	             an(TYPE_NODE, "VariableNode"),
-	             an(TYPE_NODE, "TypedVariableLink")));
-}
-
-Handle ControlPolicy::mk_list_of_args_vardecl(const Handle& args_var)
-{
-	return al(TYPED_VARIABLE_LINK,
-	          args_var,
-	          an(TYPE_NODE, "ListLink"));
-}
-
-Handle ControlPolicy::mk_expand_exec(const Handle& input_andbit_var,
-                                     const Handle& input_leaf_var,
-                                     const Handle& inf_rule,
-                                     const Handle& output_andbit_var)
-{
-	Handle expand_schema = an(SCHEMA_NODE,
-		std::move(std::string(TraceRecorder::expand_andbit_schema_name)));
-	return al(EXECUTION_LINK,
-	          expand_schema,
-	          al(LIST_LINK,
-	             al(UNQUOTE_LINK, input_andbit_var),
-	             al(UNQUOTE_LINK, input_leaf_var),
-	             al(DONT_EXEC_LINK, inf_rule)),
-	          al(UNQUOTE_LINK, output_andbit_var));
-}
-
-Handle ControlPolicy::mk_preproof_eval(const Handle& preproof_args_var)
-{
-	Handle preproof_pred = an(PREDICATE_NODE,
-	                          std::move(std::string(preproof_predicate_name)));
-	return al(EVALUATION_LINK,
-	          preproof_pred,
-	          al(UNQUOTE_LINK, preproof_args_var));
-}
-
-Handle ControlPolicy::mk_expansion_control_rules_query(const Handle& inf_rule,
-                                                       int n)
-{
-	Handle vardecl_var = an(VARIABLE_NODE, "$vardecl"),
-		vardecl_vardecl = mk_vardecl_vardecl(vardecl_var),
-
-		in_preproof_args_var = an(VARIABLE_NODE, "$in_preproof_args"),
-		in_preproof_args_vardecl = mk_list_of_args_vardecl(in_preproof_args_var),
-		in_preproof_eval = mk_preproof_eval(in_preproof_args_var),
-
-		in_andbit_var = an(VARIABLE_NODE, "$in_andbit"),
-		in_leaf_var = an(VARIABLE_NODE, "$in_leaf"),
-		out_andbit_var = an(VARIABLE_NODE, "$out_andbit"),
-		expand_exec = mk_expand_exec(in_andbit_var, in_leaf_var, inf_rule,
-		                             out_andbit_var),
-
-		out_preproof_args_var = an(VARIABLE_NODE, "$out_preproof_args"),
-		out_preproof_args_vardecl = mk_list_of_args_vardecl(out_preproof_args_var),
-		out_preproof_eval = mk_preproof_eval(out_preproof_args_var);
-
-	HandleSeq pattern_vars = mk_pattern_vars(n);
-
-	// ImplicationScope with a pattern in its antecedent to
-	// retrieve
-	HandleSeq antecedents{in_preproof_eval, expand_exec};
-	for (const Handle& pv : pattern_vars)
-		antecedents.push_back(al(UNQUOTE_LINK, pv));
-	Handle pat_expand_preproof_impl = al(QUOTE_LINK,
-	                                     al(IMPLICATION_SCOPE_LINK,
-	                                        al(UNQUOTE_LINK, vardecl_var),
-	                                        al(AND_LINK, std::move(antecedents)),
-	                                        out_preproof_eval));
-
-	// Bind of ImplicationScope with a pattern in its antecedent
-	// to retrieve
-	HandleSeq vardecls{vardecl_vardecl,
-	                   in_preproof_args_vardecl,
-	                   in_andbit_var,
-	                   in_leaf_var,
-	                   out_andbit_var,
-	                   out_preproof_args_vardecl};
-	vardecls.insert(vardecls.end(), pattern_vars.begin(), pattern_vars.end());
-
-	Handle pat_expand_preproof_impl_bl = al(BIND_LINK,
-	                                        al(VARIABLE_LIST, std::move(vardecls)),
-	                                        pat_expand_preproof_impl,
-	                                        pat_expand_preproof_impl);
-
-	return pat_expand_preproof_impl_bl;
-}
-
-HandleSeq ControlPolicy::mk_pattern_vars(int n)
-{
-	HandleSeq pattern_vars;
-	for (int i = 0; i < n; i++)
-		pattern_vars.push_back(mk_pattern_var(i));
-	return pattern_vars;
-}
-
-Handle ControlPolicy::mk_pattern_var(int i)
-{
-	std::string name = std::string("$pattern-") + std::to_string(i);
-	return an(VARIABLE_NODE, std::move(name));
+	return *_ctrl_registry->expansion_control_rules(inf_rule);
 }
 
 double ControlPolicy::get_actual_mean(TruthValuePtr tv) const
 {
 	return BetaDistribution(tv).mean();
 }
-
-#undef al
-#undef an
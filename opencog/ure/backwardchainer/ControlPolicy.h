@@ -24,10 +24,14 @@
 #define _OPENCOG_CONTROLPOLICY_H_
 
 #include <opencog/atomspace/AtomSpace.h>
+#include <opencog/unify/UnifyCache.h>
 
 #include "BIT.h"
+#include "ControlRuleRegistry.h"
 #include "../UREConfig.h"
 #include "../Rule.h"
+#include "../ActionStatistics.h"
+#include "../ChainerStats.h"
 
 class ControlPolicyUTest;
 
@@ -49,10 +53,14 @@ class ControlPolicy
 	friend class ::ControlPolicyUTest;
 public:
 	ControlPolicy(const UREConfig& ure_config, const BIT& bit,
-	              const Handle& target, AtomSpace* control_as=nullptr);
+	              const Handle& target, AtomSpace* control_as=nullptr,
+	              const ActionStatistics* action_stats=nullptr,
+	              ChainerStats* stats=nullptr,
+	              UnifyCache* unify_cache=nullptr);
 	~ControlPolicy();
 
-	const std::string preproof_predicate_name = "URE:BC:preproof-of";
+	const std::string preproof_predicate_name =
+		ControlRuleRegistry::preproof_predicate_name;
 
 	// Inference rule set for expanding and-BITs.
 	RuleSet rules;
@@ -81,6 +89,14 @@ public:
 	 */
 	static HandleSet rule_aliases(const RuleTypedSubstitutionMap& rules);
 
+	/**
+	 * Register a control rule newly added to the control AtomSpace,
+	 * so that it is taken into account by this and any other control
+	 * policy sharing the same control AtomSpace. Return true iff it
+	 * is a recognized control rule.
+	 */
+	bool add_control_rule(const Handle& ctrl_rule);
+
 private:
 	// Reference to URE configuration
 	const UREConfig& _ure_config;
@@ -95,6 +111,19 @@ private:
 	// control rule can be used to predict inference expansion.
 	HandleTVMap _default_tvs;
 
+	// Success counts of the rule aliases gathered so far. If
+	// provided and the online action statistics parameter is
+	// enabled, they are added to the default TVs.
+	const ActionStatistics* _action_stats;
+
+	// If provided, unifications of the rules against the BIT-nodes
+	// to expand are counted in it.
+	ChainerStats* _stats;
+
+	// If provided, unifications of the rules against the BIT-nodes
+	// to expand are looked up in it.
+	UnifyCache* _unify_cache;
+
 	// AtomSpace holding the inference control rules (or simply
 	// control rules for short).
 	//
@@ -106,13 +135,16 @@ private:
 	//    expand an and-BIT.
 	AtomSpace* _control_as;
 
-	// AtomSpace holding the pattern matcher queries to fetch the
-	// various control rule
-	AtomSpacePtr _query_as;
+	// Control rules of _control_as, shared amongst all control
+	// policies using the same control AtomSpace, and fetched once.
+	ControlRuleRegistryPtr _ctrl_registry;
 
-	// Map each action (inference rule expansion) to the set of
-	// control rules involving it.
-	std::map<Handle, HandleSet> _expansion_control_rules;
+	/**
+	 * Return the default TV of a rule alias, updated with the action
+	 * statistics if the online action statistics parameter is
+	 * enabled.
+	 */
+	TruthValuePtr default_tv(const Handle& rule_alias);
 
 	/**
 	 * Return all valid inference rules, in the sense that they may
@@ -253,16 +285,10 @@ private:
 
 	/**
 	 * Given an inference rule, fetch both pattern and pattern free
-	 * expansion control rules. See comments below.
-	 */
-	HandleSet fetch_expansion_control_rules(const Handle& inf_rule);
-
-	/**
-	 * Fetch control rules from _control_as involved in BIT
-	 * expansion. Informally that if and-BIT, A, is a preproof and
-	 * expands into B from L with the given rule, and follow some
-	 * pattern, then B has a probability TV of being a preproof of
-	 * T. Formally
+	 * expansion control rules. Informally that if and-BIT, A, is a
+	 * preproof and expands into B from L with the given rule, and
+	 * follow some pattern, then B has a probability TV of being a
+	 * preproof of T. Formally
 	 *
 	 * ImplicationScope <TV>
 	 *  <vardecl>
@@ -289,23 +315,12 @@ private:
 	 *      <T>
 	 *
 	 * n >= 0 is the number of patterns in addition to preproof and
-	 * expansion.
-	 */
-	HandleSet fetch_expansion_control_rules(const Handle& inf_rule, int n);
-
-	/**
-	 * Helpers to build various hypergraphs used to build various queries
+	 * expansion, for now only n <= 1 is supported.
+	 *
+	 * The queries are only run the first time a rule is fetched, see
+	 * ControlRuleRegistry.
 	 */
-	Handle mk_vardecl_vardecl(const Handle& vardecl_var);
-	Handle mk_list_of_args_vardecl(const Handle& args_var);
-	Handle mk_expand_exec(const Handle& input_andbit_var,
-	                      const Handle& input_leaf_var,
-	                      const Handle& inf_rule,
-	                      const Handle& output_andbit_var);
-	Handle mk_preproof_eval(const Handle& preproof_args_var);
-	Handle mk_expansion_control_rules_query(const Handle& inf_rule, int n);
-	HandleSeq mk_pattern_vars(int n);
-	Handle mk_pattern_var(int i);
+	HandleSet fetch_expansion_control_rules(const Handle& inf_rule);
 
 	/**
 	 * Calculate the actual mean of a TV. which is to be contrasted by
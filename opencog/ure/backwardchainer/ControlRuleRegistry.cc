@@ -0,0 +1,398 @@
+/*
+ * ControlRuleRegistry.cc
+ *
+ * Copyright (C) 2017 OpenCog Foundation
+ *
+ * Authors: Nil Geisweiller
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "ControlRuleRegistry.h"
+
+#include <algorithm>
+#include <functional>
+
+#include <opencog/util/algorithm.h>
+#include <opencog/atoms/core/ScopeLink.h>
+
+#include "TraceRecorder.h"
+#include "../URELogger.h"
+
+using namespace opencog;
+
+#define al _query_as->add_link
+#define an _query_as->add_node
+
+const std::string ControlRuleRegistry::preproof_predicate_name = "URE:BC:preproof-of";
+
+std::map<AtomSpace*, std::weak_ptr<ControlRuleRegistry>> ControlRuleRegistry::_registries;
+std::mutex ControlRuleRegistry::_registries_mutex;
+
+ControlRuleRegistryPtr ControlRuleRegistry::get(AtomSpace* control_as)
+{
+	std::lock_guard<std::mutex> lock(_registries_mutex);
+
+	// Discard registries that are no longer in use
+	for (auto it = _registries.begin(); it != _registries.end();) {
+		if (it->second.expired())
+			it = _registries.erase(it);
+		else
+			++it;
+	}
+
+	ControlRuleRegistryPtr registry = _registries[control_as].lock();
+	if (not registry) {
+		registry = std::make_shared<ControlRuleRegistry>(control_as);
+		_registries[control_as] = registry;
+	}
+	return registry;
+}
+
+ControlRuleRegistry::ControlRuleRegistry(AtomSpace* control_as)
+	: _control_as(control_as), _query_as(createAtomSpace(control_as)),
+	  _removed_control_rule(false)
+{
+	_add_connection = _control_as->atomAddedSignal().connect(
+		std::bind(&ControlRuleRegistry::on_atom_added, this,
+		          std::placeholders::_1));
+	_remove_connection = _control_as->atomRemovedSignal().connect(
+		std::bind(&ControlRuleRegistry::on_atom_removed, this,
+		          std::placeholders::_1));
+}
+
+ControlRuleRegistry::~ControlRuleRegistry()
+{
+	_control_as->atomAddedSignal().disconnect(_add_connection);
+	_control_as->atomRemovedSignal().disconnect(_remove_connection);
+}
+
+ControlRuleSetPtr
+ControlRuleRegistry::expansion_control_rules(const Handle& inf_rule_alias)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	apply_changes();
+	auto it = _expansion_control_rules.find(inf_rule_alias);
+	if (it != _expansion_control_rules.end())
+		return it->second;
+
+	ControlRuleSetPtr exp_ctrl_rules = std::make_shared<const HandleSet>(
+		fetch_expansion_control_rules(inf_rule_alias));
+	_expansion_control_rules[inf_rule_alias] = exp_ctrl_rules;
+
+	ure_logger().debug() << "Expansion control rules for "
+	                     << inf_rule_alias->to_string()
+	                     << oc_to_string(*exp_ctrl_rules);
+
+	return exp_ctrl_rules;
+}
+
+ModelSummary ControlRuleRegistry::model_summary(const Handle& ctrl_rule)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto it = _model_summaries.find(ctrl_rule);
+	if (it == _model_summaries.end())
+		it = _model_summaries.emplace(ctrl_rule, ModelSummary(ctrl_rule)).first;
+	else
+		// Its TV may have changed since the summary was made
+		it->second.set_tv(ctrl_rule->getTruthValue());
+	return it->second;
+}
+
+bool ControlRuleRegistry::add_control_rule(const Handle& ctrl_rule)
+{
+	Handle inf_rule_alias = get_expansion_rule_alias(ctrl_rule);
+	if (not inf_rule_alias)
+		return false;
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	insert_control_rule(inf_rule_alias, ctrl_rule);
+	return true;
+}
+
+void ControlRuleRegistry::clear()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_expansion_control_rules.clear();
+	_model_summaries.clear();
+}
+
+void ControlRuleRegistry::on_atom_added(const Handle& h)
+{
+	// Cheap check first, as it is called on every addition
+	if (h->get_type() != IMPLICATION_SCOPE_LINK
+	    or not get_expansion_rule_alias(h))
+		return;
+
+	std::lock_guard<std::mutex> lock(_changes_mutex);
+	_added_control_rules.push_back(h);
+}
+
+void ControlRuleRegistry::on_atom_removed(const AtomPtr& atom)
+{
+	Handle h(atom);
+	if (h->get_type() != IMPLICATION_SCOPE_LINK
+	    or not get_expansion_rule_alias(h))
+		return;
+
+	std::lock_guard<std::mutex> lock(_changes_mutex);
+	_removed_control_rule = true;
+}
+
+void ControlRuleRegistry::apply_changes()
+{
+	HandleSeq added;
+	bool removed;
+	{
+		std::lock_guard<std::mutex> lock(_changes_mutex);
+		added.swap(_added_control_rules);
+		removed = _removed_control_rule;
+		_removed_control_rule = false;
+	}
+
+	// A removed control rule may be in any fetched set, start over
+	if (removed) {
+		LAZY_URE_LOG_DEBUG << "A control rule has been removed, "
+		                   << "discard all fetched control rules";
+		_expansion_control_rules.clear();
+		_model_summaries.clear();
+		return;
+	}
+
+	for (const Handle& ctrl_rule : added)
+		insert_control_rule(get_expansion_rule_alias(ctrl_rule), ctrl_rule);
+}
+
+void ControlRuleRegistry::insert_control_rule(const Handle& inf_rule_alias,
+                                              const Handle& ctrl_rule)
+{
+	auto it = _expansion_control_rules.find(inf_rule_alias);
+	if (it != _expansion_control_rules.end()) {
+		// Copy on write, as the previous set may still be in use
+		auto ctrl_rules = std::make_shared<HandleSet>(*it->second);
+		ctrl_rules->insert(ctrl_rule);
+		it->second = ctrl_rules;
+		LAZY_URE_LOG_DEBUG << "Add expansion control rule for "
+		                   << inf_rule_alias->to_string()
+		                   << ctrl_rule->id_to_string();
+	}
+}
+
+Handle ControlRuleRegistry::get_expansion(const Handle& ctrl_rule)
+{
+	ScopeLinkPtr sc = ScopeLinkCast(ctrl_rule);
+	for (const Handle& h : sc->get_body()->getOutgoingSet())
+		if (is_expansion(h))
+			return h;
+	return Handle::UNDEFINED;
+}
+
+bool ControlRuleRegistry::is_expansion(const Handle& h)
+{
+	if (h->get_type() == EXECUTION_LINK) {
+		Handle schema = h->getOutgoingAtom(0);
+		return schema->get_name() == TraceRecorder::expand_andbit_schema_name;
+	}
+	return false;
+}
+
+bool ControlRuleRegistry::is_preproof_eval(const Handle& h)
+{
+	// Evaluation
+	//   Predicate "URE:BC:preproof-of"
+	//   List <args>
+	return h->get_type() == EVALUATION_LINK
+		and h->get_arity() == 2
+		and h->getOutgoingAtom(0)->get_type() == PREDICATE_NODE
+		and h->getOutgoingAtom(0)->get_name() == preproof_predicate_name
+		and h->getOutgoingAtom(1)->get_type() == LIST_LINK;
+}
+
+Handle ControlRuleRegistry::get_expansion_rule_alias(const Handle& ctrl_rule)
+{
+	// Only consider control rules that the queries would retrieve,
+	// see mk_expansion_control_rules_query, that is
+	//
+	// ImplicationScope
+	//   <vardecl>
+	//   And
+	//     <preproof-of-A>
+	//     <expansion>
+	//     [<pattern>]
+	//   <preproof-of-B>
+	if (ctrl_rule->get_type() != IMPLICATION_SCOPE_LINK
+	    or ctrl_rule->get_arity() != 3)
+		return Handle::UNDEFINED;
+	Type vardecl_type = ctrl_rule->getOutgoingAtom(0)->get_type();
+	if (vardecl_type != VARIABLE_LIST and vardecl_type != VARIABLE_NODE
+	    and vardecl_type != TYPED_VARIABLE_LINK)
+		return Handle::UNDEFINED;
+	if (not is_preproof_eval(ctrl_rule->getOutgoingAtom(2)))
+		return Handle::UNDEFINED;
+	const Handle& body = ctrl_rule->getOutgoingAtom(1);
+	if (body->get_type() != AND_LINK
+	    or body->get_arity() < 2 or 3 < body->get_arity())
+		return Handle::UNDEFINED;
+	const HandleSeq& antecedents = body->getOutgoingSet();
+	if (std::none_of(antecedents.begin(), antecedents.end(),
+	                 is_preproof_eval))
+		return Handle::UNDEFINED;
+
+	// Get the expansion, then the inference rule alias wrapped in a
+	// DontExecLink
+	//
+	// Execution
+	//   Schema "URE:BC:expand-and-BIT"
+	//   List <A> <L> (DontExec <inf_rule>)
+	//   <B>
+	Handle expansion = get_expansion(ctrl_rule);
+	if (not expansion or expansion->get_arity() != 3
+	    or expansion->getOutgoingAtom(0)->get_type() != SCHEMA_NODE)
+		return Handle::UNDEFINED;
+	const Handle& args = expansion->getOutgoingAtom(1);
+	if (args->get_type() != LIST_LINK or args->get_arity() != 3)
+		return Handle::UNDEFINED;
+	const Handle& dont_exec = args->getOutgoingAtom(2);
+	if (dont_exec->get_type() != DONT_EXEC_LINK or dont_exec->get_arity() != 1)
+		return Handle::UNDEFINED;
+	return dont_exec->getOutgoingAtom(0);
+}
+
+HandleSet ControlRuleRegistry::fetch_expansion_control_rules(const Handle& inf_rule)
+{
+	return set_union(fetch_expansion_control_rules(inf_rule, 0),
+	                 fetch_expansion_control_rules(inf_rule, 1));
+}
+
+HandleSet ControlRuleRegistry::fetch_expansion_control_rules(const Handle& inf_rule,
+                                                             int n)
+{
+	Handle query = mk_expansion_control_rules_query(inf_rule, n);
+	Handle result = HandleCast(query->execute(_control_as));
+	HandleSeq outgoings(result->getOutgoingSet());
+	_control_as->remove_atom(result); // Remove cruft from _control_as
+	return HandleSet(outgoings.begin(), outgoings.end());
+}
+
+Handle ControlRuleRegistry::mk_vardecl_vardecl(const Handle& vardecl_var)
+{
+	return al(TYPED_VARIABLE_LINK,
+	          vardecl_var,
+	          al(TYPE_CHOICE,
+	             an(TYPE_NODE, "VariableList"),
+	             an(TYPE_NODE, "VariableNode"),
+	             an(TYPE_NODE, "TypedVariableLink")));
+}
+
+Handle ControlRuleRegistry::mk_list_of_args_vardecl(const Handle& args_var)
+{
+	return al(TYPED_VARIABLE_LINK,
+	          args_var,
+	          an(TYPE_NODE, "ListLink"));
+}
+
+Handle ControlRuleRegistry::mk_expand_exec(const Handle& input_andbit_var,
+                                           const Handle& input_leaf_var,
+                                           const Handle& inf_rule,
+                                           const Handle& output_andbit_var)
+{
+	Handle expand_schema = an(SCHEMA_NODE,
+		std::move(std::string(TraceRecorder::expand_andbit_schema_name)));
+	return al(EXECUTION_LINK,
+	          expand_schema,
+	          al(LIST_LINK,
+	             al(UNQUOTE_LINK, input_andbit_var),
+	             al(UNQUOTE_LINK, input_leaf_var),
+	             al(DONT_EXEC_LINK, inf_rule)),
+	          al(UNQUOTE_LINK, output_andbit_var));
+}
+
+Handle ControlRuleRegistry::mk_preproof_eval(const Handle& preproof_args_var)
+{
+	Handle preproof_pred = an(PREDICATE_NODE,
+	                          std::move(std::string(preproof_predicate_name)));
+	return al(EVALUATION_LINK,
+	          preproof_pred,
+	          al(UNQUOTE_LINK, preproof_args_var));
+}
+
+Handle ControlRuleRegistry::mk_expansion_control_rules_query(const Handle& inf_rule,
+                                                             int n)
+{
+	Handle vardecl_var = an(VARIABLE_NODE, "$vardecl"),
+		vardecl_vardecl = mk_vardecl_vardecl(vardecl_var),
+
+		in_preproof_args_var = an(VARIABLE_NODE, "$in_preproof_args"),
+		in_preproof_args_vardecl = mk_list_of_args_vardecl(in_preproof_args_var),
+		in_preproof_eval = mk_preproof_eval(in_preproof_args_var),
+
+		in_andbit_var = an(VARIABLE_NODE, "$in_andbit"),
+		in_leaf_var = an(VARIABLE_NODE, "$in_leaf"),
+		out_andbit_var = an(VARIABLE_NODE, "$out_andbit"),
+		expand_exec = mk_expand_exec(in_andbit_var, in_leaf_var, inf_rule,
+		                             out_andbit_var),
+
+		out_preproof_args_var = an(VARIABLE_NODE, "$out_preproof_args"),
+		out_preproof_args_vardecl = mk_list_of_args_vardecl(out_preproof_args_var),
+		out_preproof_eval = mk_preproof_eval(out_preproof_args_var);
+
+	HandleSeq pattern_vars = mk_pattern_vars(n);
+
+	// ImplicationScope with a pattern in its antecedent to
+	// retrieve
+	HandleSeq antecedents{in_preproof_eval, expand_exec};
+	for (const Handle& pv : pattern_vars)
+		antecedents.push_back(al(UNQUOTE_LINK, pv));
+	Handle pat_expand_preproof_impl = al(QUOTE_LINK,
+	                                     al(IMPLICATION_SCOPE_LINK,
+	                                        al(UNQUOTE_LINK, vardecl_var),
+	                                        al(AND_LINK, std::move(antecedents)),
+	                                        out_preproof_eval));
+
+	// Bind of ImplicationScope with a pattern in its antecedent
+	// to retrieve
+	HandleSeq vardecls{vardecl_vardecl,
+	                   in_preproof_args_vardecl,
+	                   in_andbit_var,
+	                   in_leaf_var,
+	                   out_andbit_var,
+	                   out_preproof_args_vardecl};
+	vardecls.insert(vardecls.end(), pattern_vars.begin(), pattern_vars.end());
+
+	Handle pat_expand_preproof_impl_bl = al(BIND_LINK,
+	                                        al(VARIABLE_LIST, std::move(vardecls)),
+	                                        pat_expand_preproof_impl,
+	                                        pat_expand_preproof_impl);
+
+	return pat_expand_preproof_impl_bl;
+}
+
+HandleSeq ControlRuleRegistry::mk_pattern_vars(int n)
+{
+	HandleSeq pattern_vars;
+	for (int i = 0; i < n; i++)
+		pattern_vars.push_back(mk_pattern_var(i));
+	return pattern_vars;
+}
+
+Handle ControlRuleRegistry::mk_pattern_var(int i)
+{
+	std::string name = std::string("$pattern-") + std::to_string(i);
+	return an(VARIABLE_NODE, std::move(name));
+}
+
+#undef al
+#undef an
@@ -0,0 +1,211 @@
+/*
+ * ControlRuleRegistry.h
+ *
+ * Copyright (C) 2017 OpenCog Foundation
+ *
+ * Authors: Nil Geisweiller
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#ifndef _OPENCOG_CONTROLRULEREGISTRY_H_
+#define _OPENCOG_CONTROLRULEREGISTRY_H_
+
+#include <mutex>
+
+#include <opencog/atomspace/AtomSpace.h>
+
+#include "../MixtureModel.h"
+
+namespace opencog
+{
+
+class ControlRuleRegistry;
+typedef std::shared_ptr<ControlRuleRegistry> ControlRuleRegistryPtr;
+
+// Immutable snapshot of a set of control rules
+typedef std::shared_ptr<const HandleSet> ControlRuleSetPtr;
+
+/**
+ * Registry of inference control rules present in a given control
+ * AtomSpace.
+ *
+ * Fetching control rules requires running pattern matcher queries
+ * over the control AtomSpace, which can be expensive when it holds
+ * many control rules. The registry runs these queries once per
+ * inference rule alias, lazily, and keeps the results so that all
+ * control policies (thus all backward chainers) running over the
+ * same control AtomSpace can share them. Use get() to obtain the
+ * registry associated to a control AtomSpace.
+ *
+ * The registry listens to the control AtomSpace, so that expansion
+ * control rules added to it after the registry has been populated
+ * are registered incrementally, without having to re-run the
+ * queries, while the removal of a control rule discards all fetched
+ * control rules, to be queried again on the next request.
+ */
+class ControlRuleRegistry
+{
+public:
+	static const std::string preproof_predicate_name;
+
+	/**
+	 * Return the registry shared by all users of control_as. A new
+	 * one is created if none is currently alive.
+	 */
+	static ControlRuleRegistryPtr get(AtomSpace* control_as);
+
+	ControlRuleRegistry(AtomSpace* control_as);
+	~ControlRuleRegistry();
+
+	/**
+	 * Return all expansion control rules involving the given
+	 * inference rule alias. The control AtomSpace is only queried the
+	 * first time a given alias is requested, or after a control rule
+	 * has been removed.
+	 *
+	 * The returned snapshot is not affected by subsequent updates of
+	 * the registry, and is cheap to obtain.
+	 */
+	ControlRuleSetPtr expansion_control_rules(const Handle& inf_rule_alias);
+
+	/**
+	 * Return the model summary of the given control rule, used to
+	 * calculate the TV of mixtures of control rules. Its length is
+	 * calculated only once per control rule, while the quantities
+	 * depending on its TV are updated whenever the TV changes.
+	 */
+	ModelSummary model_summary(const Handle& ctrl_rule);
+
+	/**
+	 * Register a control rule of the control AtomSpace, updating the
+	 * already fetched alias it involves (aliases not fetched yet will
+	 * get it from the query). Return true iff ctrl_rule is an
+	 * expansion control rule.
+	 *
+	 * Control rules added to the control AtomSpace are registered
+	 * automatically, so calling this is only needed for control
+	 * rules added before the registry was created.
+	 */
+	bool add_control_rule(const Handle& ctrl_rule);
+
+	/**
+	 * Forget all fetched control rules and their summaries, so that
+	 * the next request will query the control AtomSpace again.
+	 */
+	void clear();
+
+	/**
+	 * Given a control rule, get the antecedent part concerning the
+	 * expansion, see ControlPolicy::get_expansion.
+	 */
+	static Handle get_expansion(const Handle& ctrl_rule);
+	static bool is_expansion(const Handle& h);
+
+	/**
+	 * Return true iff h is a preproof evaluation, i.e.
+	 *
+	 * Evaluation
+	 *   Predicate "URE:BC:preproof-of"
+	 *   List <args>
+	 */
+	static bool is_preproof_eval(const Handle& h);
+
+	/**
+	 * Given a control rule, return the inference rule alias of its
+	 * expansion, or Handle::UNDEFINED if it isn't an expansion
+	 * control rule, with the shape the queries retrieve.
+	 */
+	static Handle get_expansion_rule_alias(const Handle& ctrl_rule);
+
+private:
+	// AtomSpace holding the inference control rules
+	AtomSpace* _control_as;
+
+	// AtomSpace holding the pattern matcher queries to fetch the
+	// various control rule
+	AtomSpacePtr _query_as;
+
+	// Map each action (inference rule expansion) to the set of
+	// control rules involving it. Only aliases that have been
+	// fetched are present.
+	std::map<Handle, ControlRuleSetPtr> _expansion_control_rules;
+
+	// Map each control rule to its model summary
+	std::map<Handle, ModelSummary> _model_summaries;
+
+	// Map control AtomSpaces to their registries
+	static std::map<AtomSpace*, std::weak_ptr<ControlRuleRegistry>> _registries;
+	static std::mutex _registries_mutex;
+
+	// TODO: subdivide in smaller and shared mutexes
+	mutable std::mutex _mutex;
+
+	// Connections to the addition and removal signals of the control
+	// AtomSpace
+	int _add_connection;
+	int _remove_connection;
+
+	// Expansion control rules added to the control AtomSpace, and
+	// whether one has been removed, since the last update. They are
+	// only recorded by the signal handlers, which may be called from
+	// any thread, and applied on the next request, see
+	// apply_changes.
+	HandleSeq _added_control_rules;
+	bool _removed_control_rule;
+	std::mutex _changes_mutex;
+
+	void on_atom_added(const Handle& h);
+	void on_atom_removed(const AtomPtr& atom);
+
+	/**
+	 * Apply the changes recorded by the signal handlers. Must be
+	 * called while holding _mutex.
+	 */
+	void apply_changes();
+
+	/**
+	 * Insert ctrl_rule in the already fetched control rules of its
+	 * alias, if any. Must be called
+	 * while holding _mutex.
+	 */
+	void insert_control_rule(const Handle& inf_rule_alias,
+	                         const Handle& ctrl_rule);
+
+	/**
+	 * Given an inference rule, fetch both pattern and pattern free
+	 * expansion control rules. See ControlPolicy for their format.
+	 */
+	HandleSet fetch_expansion_control_rules(const Handle& inf_rule);
+	HandleSet fetch_expansion_control_rules(const Handle& inf_rule, int n);
+
+	/**
+	 * Helpers to build various hypergraphs used to build various queries
+	 */
+	Handle mk_vardecl_vardecl(const Handle& vardecl_var);
+	Handle mk_list_of_args_vardecl(const Handle& args_var);
+	Handle mk_expand_exec(const Handle& input_andbit_var,
+	                      const Handle& input_leaf_var,
+	                      const Handle& inf_rule,
+	                      const Handle& output_andbit_var);
+	Handle mk_preproof_eval(const Handle& preproof_args_var);
+	Handle mk_expansion_control_rules_query(const Handle& inf_rule, int n);
+	HandleSeq mk_pattern_vars(int n);
+	Handle mk_pattern_var(int i);
+};
+
+} // namespace opencog
+
+#endif /* _OPENCOG_CONTROLRULEREGISTRY_H_ */
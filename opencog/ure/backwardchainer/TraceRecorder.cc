@@ -31,7 +31,9 @@ const std::string TraceRecorder::andbit_predicate_name = "URE:BC:and-BIT";
 const std::string TraceRecorder::expand_andbit_schema_name = "URE:BC:expand-and-BIT";
 const std::string TraceRecorder::proof_predicate_name = "URE:BC:proof-of";
 
-TraceRecorder::TraceRecorder(AtomSpace* tr_as) : _trace_as(tr_as) {
+TraceRecorder::TraceRecorder(AtomSpace* tr_as, ActionStatistics* action_stats,
+                             ChainerStats* stats)
+	: _trace_as(tr_as), _action_stats(action_stats), _stats(stats) {
 	if (_trace_as) {
 		_target_predicate =
 			_trace_as->add_node(PREDICATE_NODE, std::move(std::string(target_predicate_name)));
@@ -44,6 +46,13 @@ TraceRecorder::TraceRecorder(AtomSpace* tr_as) : _trace_as(tr_as) {
 	}
 }
 
+void TraceRecorder::set_action_statistics(ActionStatistics* action_stats)
+{
+	_action_stats = action_stats;
+	_expansion_origins.clear();
+	_successful_expansions.clear();
+}
+
 HandleSeqSet TraceRecorder::traces()
 {
 	HandleSeqSet trs;
@@ -84,6 +93,9 @@ void TraceRecorder::andbit(const AndBIT& andbit)
 	add_evaluation(_andbit_predicate,
 	               dont_exec(andbit.fcs),
 	               TruthValue::TRUE_TV());
+
+	if (_stats)
+		_stats->add(ChainerStats::ANDBITS_CREATED);
 }
 
 void TraceRecorder::expansion(const Handle& andbit_fcs, const Handle& bitleaf_body,
@@ -93,6 +105,11 @@ void TraceRecorder::expansion(const Handle& andbit_fcs, const Handle& bitleaf_bo
 	              dont_exec(andbit_fcs), bitleaf_body,
 	              dont_exec(rule.get_alias()),
 	              dont_exec(new_andbit.fcs), TruthValue::TRUE_TV());
+
+	if (_action_stats) {
+		_action_stats->add_trial(rule.get_alias());
+		_expansion_origins[new_andbit.fcs] = {andbit_fcs, rule.get_alias()};
+	}
 }
 
 void TraceRecorder::proof(const Handle& andbit_fcs, const Handle& target_result)
@@ -100,6 +117,21 @@ void TraceRecorder::proof(const Handle& andbit_fcs, const Handle& target_result)
 	add_evaluation(_proof_predicate,
 	               dont_exec(andbit_fcs), target_result,
 	               target_result->getTruthValue());
+
+	if (_stats)
+		_stats->add(ChainerStats::FCS_RESULTS);
+
+	if (_action_stats) {
+		// Walk back the expansions that have led to andbit_fcs
+		Handle fcs = andbit_fcs;
+		auto it = _expansion_origins.find(fcs);
+		while (it != _expansion_origins.end()
+		       and _successful_expansions.insert(fcs).second) {
+			_action_stats->add_success(it->second.second);
+			fcs = it->second.first;
+			it = _expansion_origins.find(fcs);
+		}
+	}
 }
 
 Handle TraceRecorder::dont_exec(const Handle& h)
@@ -27,6 +27,8 @@
 
 #include "BIT.h"
 #include "../Rule.h"
+#include "../ActionStatistics.h"
+#include "../ChainerStats.h"
 
 namespace opencog
 {
@@ -39,7 +41,17 @@ public:
 	static const std::string expand_andbit_schema_name;
 	static const std::string proof_predicate_name;
 
-	TraceRecorder(AtomSpace* tr_as);
+	// If action_stats is provided, expansions and proofs are also
+	// used to update the success counts of the rule aliases, see
+	// expansion and proof. Likewise, if stats is provided, and-BITs
+	// and proofs are counted in it. This is independent of tr_as
+	// being null.
+	TraceRecorder(AtomSpace* tr_as, ActionStatistics* action_stats=nullptr,
+	              ChainerStats* stats=nullptr);
+
+	// Set the action statistics to update, or disable their update
+	// if null. Already recorded expansions are forgotten.
+	void set_action_statistics(ActionStatistics* action_stats);
 
 	// Return the traces of fcs leading to the recorded proofs
 	HandleSeqSet traces();
@@ -61,6 +73,9 @@ public:
 	// Evaluation (stv 1 1)
 	//   Predicate "URE:BC:and-BIT"
 	//   <and-BIT>
+	//
+	// Also count the creation of an and-BIT in the chainer
+	// statistics, if any.
 	void andbit(const AndBIT& andbit);
 
 	// Record and-BIT expansion to _trace_as
@@ -76,6 +91,9 @@ public:
 	// The andbit and its bitleaf are passed as Handles because by the
 	// time this called they have gotten corrupted (but not their
 	// handles).
+	//
+	// Also count a trial of the rule alias in the action statistics,
+	// if any.
 	void expansion(const Handle& andbit_fcs, const Handle& bitleaf_body,
 	               const Rule& rule, const AndBIT& new_andbit);
 
@@ -94,6 +112,11 @@ public:
 	// TODO: the TV on the evaluation link should be more carefully
 	// thought. For instance maybe it was already proved to begin
 	// with.
+	//
+	// Also count a success for the rule alias of each expansion
+	// that has led to andbit_fcs, in the action statistics if any.
+	// Each expansion is counted at most once. And count the result in
+	// the chainer statistics, if any.
 	void proof(const Handle& andbit_fcs, const Handle& target_result);
 
 private:
@@ -102,6 +125,20 @@ private:
 	Handle _target_predicate, _andbit_predicate, _expand_andbit_schema,
 		_proof_predicate;
 
+	ActionStatistics* _action_stats;
+
+	ChainerStats* _stats;
+
+	// Map each expanded fcs to the fcs it has been expanded from and
+	// the rule alias used for that expansion. Only used when
+	// _action_stats is non null, so that proofs can be traced back
+	// without requiring _trace_as.
+	std::map<Handle, std::pair<Handle, Handle>> _expansion_origins;
+
+	// Set of fcs whose expansion has already been counted as
+	// successful
+	HandleSet _successful_expansions;
+
 	// Wrap a DontExecLink around h
 	//
 	// DontExecLink
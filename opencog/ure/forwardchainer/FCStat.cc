@@ -26,13 +26,36 @@
 
 using namespace opencog;
 
+FCStat::FCStat(AtomSpace* trace_as, int max_records)
+	: _arena_offset(0), _num_records(0), _num_record_products(0),
+	  _max_records(max_records), _trace_as(trace_as) {}
+
+void FCStat::set_max_records(int max_records)
+{
+	std::lock_guard<std::mutex> lock(_whole_mutex);
+	_max_records = max_records;
+	discard_records();
+}
+
 void FCStat::add_inference_record(unsigned iteration, Handle source,
                                   const Rule& rule,
                                   const HandleSet& product)
 {
+	Handle rule_h = rule.get_alias() ? rule.get_alias() : rule.get_rule();
 	{
 		std::lock_guard<std::mutex> lock(_whole_mutex);
-		_inf_rec.emplace_back(source, rule, product);
+		_num_records++;
+		_num_record_products += product.size();
+		_all_products.insert(product.begin(), product.end());
+
+		if (_max_records != 0) {
+			size_t begin = _arena_offset + _product_arena.size();
+			for (const Handle& h : product)
+				_product_arena.push_back(intern(h));
+			_records.push_back({iteration, intern(source), intern(rule_h),
+			                    begin, _arena_offset + _product_arena.size()});
+			discard_records();
+		}
 	}
 
 	if (_trace_as and not product.empty()) {
@@ -48,9 +71,91 @@ void FCStat::add_inference_record(unsigned iteration, Handle source,
 HandleSet FCStat::get_all_products() const
 {
 	std::lock_guard<std::mutex> lock(_whole_mutex);
-	HandleSet all;
-	for(const auto& ir : _inf_rec)
-		all.insert(ir.product.begin(),ir.product.end());
+	return _all_products;
+}
+
+std::vector<InferenceRecord> FCStat::get_records() const
+{
+	std::lock_guard<std::mutex> lock(_whole_mutex);
+	std::vector<InferenceRecord> records;
+	records.reserve(_records.size());
+	for (const Record& rec : _records) {
+		HandleSeq product;
+		product.reserve(rec.product_end - rec.product_begin);
+		for (size_t i = rec.product_begin; i < rec.product_end; i++)
+			product.push_back(_handles[_product_arena[i - _arena_offset]]);
+		records.push_back({rec.iteration, _handles[rec.source],
+		                   _handles[rec.rule], std::move(product)});
+	}
+	return records;
+}
+
+size_t FCStat::get_num_records() const
+{
+	std::lock_guard<std::mutex> lock(_whole_mutex);
+	return _num_records;
+}
+
+size_t FCStat::get_num_record_products() const
+{
+	std::lock_guard<std::mutex> lock(_whole_mutex);
+	return _num_record_products;
+}
+
+size_t FCStat::get_num_interned() const
+{
+	std::lock_guard<std::mutex> lock(_whole_mutex);
+	return _handle_ids.size();
+}
+
+unsigned FCStat::intern(const Handle& h)
+{
+	auto it = _handle_ids.find(h);
+	if (it != _handle_ids.end()) {
+		_ref_counts[it->second]++;
+		return it->second;
+	}
+	unsigned id;
+	if (_free_ids.empty()) {
+		id = _handles.size();
+		_handles.push_back(h);
+		_ref_counts.push_back(1);
+	} else {
+		id = _free_ids.back();
+		_free_ids.pop_back();
+		_handles[id] = h;
+		_ref_counts[id] = 1;
+	}
+	_handle_ids.emplace(h, id);
+	return id;
+}
 
-	return all;
+void FCStat::release(unsigned id)
+{
+	if (--_ref_counts[id] != 0)
+		return;
+	_handle_ids.erase(_handles[id]);
+	_handles[id] = Handle::UNDEFINED;
+	_free_ids.push_back(id);
+}
+
+void FCStat::discard_records()
+{
+	if (_max_records < 0)
+		return;
+
+	while ((size_t)_max_records < _records.size()) {
+		// Products are appended in the same order as records, thus
+		// the products of the oldest record are at the front.
+		const Record& rec = _records.front();
+		size_t product_size = rec.product_end - rec.product_begin;
+		for (size_t i = 0; i < product_size; i++)
+			release(_product_arena[i]);
+		release(rec.source);
+		release(rec.rule);
+		_product_arena.erase(_product_arena.begin(),
+		                     std::next(_product_arena.begin(), product_size));
+		_arena_offset += product_size;
+		_records.pop_front();
+	}
 }
@@ -24,27 +24,46 @@
 #ifndef _OPENCOG_FCSTAT_H_
 #define _OPENCOG_FCSTAT_H_
 
-#include <map>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 #include <opencog/atoms/base/Handle.h>
 #include <opencog/ure/Rule.h>
 
 namespace opencog {
 
+/**
+ * Inference record, as returned by FCStat::get_records.
+ */
 struct InferenceRecord
 {
-	const Handle hsource;
-	const Rule& rule;
-	HandleSet product;
-
-	InferenceRecord(Handle h, const Rule& r, const HandleSet& p)
-		: hsource(h), rule(r), product(p) {}
+	unsigned iteration;
+	Handle source;
+	Handle rule;                // rule alias, or body if it has none
+	HandleSeq product;
 };
 
 class FCStat
 {
 public:
-	FCStat(AtomSpace* trace_as) : _trace_as(trace_as) {}
+	/**
+	 * @param trace_as    AtomSpace to record the inference traces, if any
+	 * @param max_records Maximum number of inference records to
+	 *                    retain, see set_max_records.
+	 */
+	FCStat(AtomSpace* trace_as, int max_records=-1);
+
+	/**
+	 * Set the maximum number of inference records to retain, the
+	 * oldest being discarded beyond it. Negative means the full trace
+	 * is retained, zero means only the counts are.
+	 *
+	 * Either way the union of all products is maintained, as well as
+	 * the trace in the trace atomspace, if any.
+	 */
+	void set_max_records(int max_records);
 
 	/**
 	 * Record the inference step into memory, as well as in the
@@ -66,15 +85,77 @@ public:
 	 */
 	void add_inference_record(unsigned iteration, Handle source,
 	                          const Rule& rule, const HandleSet& product);
+
+	/**
+	 * Return the union of all products.
+	 */
 	HandleSet get_all_products() const;
-	HandleSet get_all_products();
+
+	/**
+	 * Return the retained inference records, from oldest to newest.
+	 */
+	std::vector<InferenceRecord> get_records() const;
+
+	/**
+	 * Return the number of inference records added so far, retained
+	 * or not, and the total number of products they contain.
+	 */
+	size_t get_num_records() const;
+	size_t get_num_record_products() const;
+
+	/**
+	 * Return the number of distinct handles, sources, rules or
+	 * products, referenced by the retained inference records.
+	 */
+	size_t get_num_interned() const;
 
 private:
-	std::vector<InferenceRecord> _inf_rec;
+	// Compact inference record, handles are interned, and products
+	// are stored contiguously in _product_arena, from product_begin
+	// to product_end, both offset by _arena_offset.
+	struct Record
+	{
+		unsigned iteration;
+		unsigned source;
+		unsigned rule;
+		size_t product_begin;
+		size_t product_end;
+	};
+
+	// Interned handles, and the number of references to them from
+	// the retained records. Handles no longer referenced are released
+	// and their ids are reused.
+	HandleSeq _handles;
+	std::vector<unsigned> _ref_counts;
+	std::vector<unsigned> _free_ids;
+	std::unordered_map<Handle, unsigned> _handle_ids;
+
+	// Retained records and their products. _arena_offset is the
+	// number of products discarded from the front of the arena.
+	std::deque<Record> _records;
+	std::deque<unsigned> _product_arena;
+	size_t _arena_offset;
+
+	// Union of all products, maintained incrementally
+	HandleSet _all_products;
+
+	// Counts of all records and their products, retained or not
+	size_t _num_records;
+	size_t _num_record_products;
+
+	int _max_records;
 	AtomSpace* _trace_as;
 
 	// TODO: subdivide in smaller and shared mutexes
 	mutable std::mutex _whole_mutex;
+
+	// Intern h, or add a reference to it if already, and return its
+	// id. Release removes a reference to the handle of the given id.
+	unsigned intern(const Handle& h);
+	void release(unsigned id);
+
+	// Discard the oldest records beyond _max_records
+	void discard_records();
 };
 
 }
@@ -23,6 +23,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
 #include <future>
 #include <thread>
 #include <chrono>
@@ -33,15 +34,18 @@
 #include <opencog/util/pool.h>
 #include <opencog/atoms/core/VariableList.h>
 #include <opencog/atoms/core/FindUtils.h>
+#include <opencog/atoms/execution/ExecutionOutputLink.h>
 #include <opencog/atoms/pattern/BindLink.h>
 #include <opencog/atoms/pattern/PatternUtils.h>
 #include <opencog/atoms/truthvalue/TruthValue.h>
 #include <opencog/ure/Rule.h>
+#include <opencog/unify/UnifyCache.h>
 
 #include "ForwardChainer.h"
 #include "../URELogger.h"
 #include "../backwardchainer/ControlPolicy.h"
 #include "../ThompsonSampling.h"
+#include "../SelectionPolicy.h"
 
 using namespace opencog;
 
@@ -57,7 +61,7 @@ ForwardChainer::ForwardChainer(AtomSpace& kb_as,
 	  _config(rb_as, rbs),
 	  _thread_count(0),
 	  _sources(_config, source, vardecl),
-	  _fcstat(trace_as),
+	  _fcstat(trace_as, _config.get_max_inference_records()),
 	  _srpi(true)
 {
 	init(source, vardecl, focus_set);
@@ -122,6 +126,14 @@ void ForwardChainer::do_chain()
 	ure_logger().debug("Start forward chaining");
 	LAZY_URE_LOG_DEBUG << "With rule set:" << std::endl << oc_to_string(_rules);
 
+	_fcstat.set_max_records(_config.get_max_inference_records());
+	_unify_cache.set_max_size(std::max(0, _config.get_unification_cache_size()));
+	size_t unify_cache_hits = _unify_cache.get_hits(),
+		unify_cache_misses = _unify_cache.get_misses();
+	_phase_timers.clear();
+	_phase_timers.set_enabled(_config.get_phase_timing());
+	_stats.clear();
+
 	// Relex2Logic uses this. TODO make a separate class to handle
 	// this robustly.
 	if(_sources.empty())
@@ -153,6 +165,17 @@ void ForwardChainer::do_chain()
 
 	// Log termination messages
 	termination_log();
+	tally_sources();
+	_stats.set(ChainerStats::UNIFY_CACHE_HITS,
+	           _unify_cache.get_hits() - unify_cache_hits);
+	_stats.set(ChainerStats::UNIFY_CACHE_MISSES,
+	           _unify_cache.get_misses() - unify_cache_misses);
+	LAZY_URE_LOG_DEBUG << "Unification cache: " << oc_to_string(_unify_cache);
+	if (_phase_timers.is_enabled())
+		LAZY_URE_LOG_DEBUG << "Phase timers:" << std::endl
+		                   << oc_to_string(_phase_timers);
+	LAZY_URE_LOG_DEBUG << "Chainer statistics:" << std::endl
+	                   << oc_to_string(_stats);
 	LAZY_URE_LOG_DEBUG << "Finished forward chaining with results:"
 	                   << std::endl << oc_to_string(get_results_set());
 }
@@ -236,16 +259,28 @@ void ForwardChainer::do_step(int iteration)
 	bool success = source->insert_rule(rule);
 	if (success) {
 		// Apply rule on source
-		HandleSet products = apply_rule(*rule);
+		HandleSet products = apply_rule(SourceRule(source, rule));
+		_stats.add(ChainerStats::RULE_APPLICATIONS);
+		_stats.add(ChainerStats::RULE_PRODUCTS, products.size());
 
 		// Insert the produced sources in the population of sources
-		_sources.insert(products, *source, prob, msgprfx);
+		{
+			PhaseTimers::Scope scope(_phase_timers, "insert_sources");
+			size_t inserted = _sources.insert(products, *source, prob, msgprfx);
+			_stats.add(ChainerStats::SOURCES_INSERTED, inserted);
+			_stats.add(ChainerStats::SOURCES_REJECTED_DUPLICATE,
+			           products.size() - inserted);
+		}
+
+		// Pass the products to the callback, if any
+		stream_products(products);
 
 		// The rule has been applied, we can set the exhausted flag
 		source->set_rule_exhausted(rule);
 
 		// Save trace and results
-		_fcstat.add_inference_record(iteration, source->body, *rule, products);
+		_fcstat.add_inference_record(iteration, source->body, *rule,
+		                             products);
 	} else {
 		LAZY_URE_LOG_DEBUG << msgprfx << "Rule " << rule->to_short_string()
 		                   << " is probably being applied on source "
@@ -279,6 +314,8 @@ void ForwardChainer::do_step_srpi(int iteration)
 
 		// Apply selected source rule pair
 		HandleSet products = apply_rule(slc_sr);
+		_stats.add(ChainerStats::RULE_APPLICATIONS);
+		_stats.add(ChainerStats::RULE_PRODUCTS, products.size());
 
 		// Insert the produced sources in the population of sources
 		//
@@ -290,7 +327,16 @@ void ForwardChainer::do_step_srpi(int iteration)
 		// replaced by do_step_srpi.
 		double weight = std::min(1.0, slc_sr.source->weight);
 		double prob = success_plty / weight;
-		_sources.insert(products, *slc_sr.source, prob, msgprfx);
+		{
+			PhaseTimers::Scope scope(_phase_timers, "insert_sources");
+			size_t inserted = _sources.insert(products, *slc_sr.source, prob, msgprfx);
+			_stats.add(ChainerStats::SOURCES_INSERTED, inserted);
+			_stats.add(ChainerStats::SOURCES_REJECTED_DUPLICATE,
+			           products.size() - inserted);
+		}
+
+		// Pass the products to the callback, if any
+		stream_products(products);
 
 		// The rule has been applied, we can set the exhausted flag
 		slc_sr.source->set_rule_exhausted(slc_sr.rule);
@@ -339,6 +385,21 @@ void ForwardChainer::termination_log()
 	ure_logger().debug() << "Terminate: " << msg;
 }
 
+void ForwardChainer::tally_sources()
+{
+	size_t tried = 0, rules = 0, max_rules = 0;
+	for (const SourcePtr& src : _sources.sources) {
+		size_t src_rules = src->rules.size();
+		if (0 < src_rules)
+			tried++;
+		rules += src_rules;
+		max_rules = std::max(max_rules, src_rules);
+	}
+	_stats.set(ChainerStats::SOURCES_TRIED, tried);
+	_stats.set(ChainerStats::RULES_TRIED, rules);
+	_stats.set(ChainerStats::MAX_RULES_PER_SOURCE, max_rules);
+}
+
 /**
  * Applies all rules in the rule base.
  */
@@ -347,6 +408,9 @@ void ForwardChainer::apply_all_rules()
 	for (const RulePtr& rule : _rules) {
 		ure_logger().debug("Apply rule %s", rule->get_name().c_str());
 		HandleSet uhs = apply_rule(*rule);
+		_stats.add(ChainerStats::RULE_APPLICATIONS);
+		_stats.add(ChainerStats::RULE_PRODUCTS, uhs.size());
+		stream_products(uhs);
 
 		// Update
 		_fcstat.add_inference_record(_iteration,
@@ -367,8 +431,48 @@ HandleSet ForwardChainer::get_results_set() const
 	return _fcstat.get_all_products();
 }
 
+int ForwardChainer::get_iteration() const
+{
+	return _iteration;
+}
+
+const PhaseTimers& ForwardChainer::get_phase_timers() const
+{
+	return _phase_timers;
+}
+
+const ChainerStats& ForwardChainer::get_stats() const
+{
+	return _stats;
+}
+
+void ForwardChainer::set_product_callback(const ProductCallback& callback)
+{
+	std::lock_guard<std::mutex> lock(_product_callback_mutex);
+	_product_callback = callback;
+}
+
+void ForwardChainer::set_product_callback(const Handle& schema)
+{
+	set_product_callback([this, schema](const HandleSet& products) {
+			HandleSeq prods(products.begin(), products.end());
+			Handle args = createLink(HandleSeq{createLink(std::move(prods), SET_LINK)},
+			                         LIST_LINK);
+			createExecutionOutputLink(schema, args)->execute(&_kb_as);
+		});
+}
+
+void ForwardChainer::stream_products(const HandleSet& products)
+{
+	std::lock_guard<std::mutex> lock(_product_callback_mutex);
+	if (_product_callback and not products.empty())
+		_product_callback(products);
+}
+
 SourcePtr ForwardChainer::select_source(const std::string& msgprfx)
 {
+	PhaseTimers::Scope scope(_phase_timers, "select_source");
+
 	// TODO: refine mutex
 	std::unique_lock<std::mutex> lock(_part_mutex);
 
@@ -454,9 +558,11 @@ SourceRule ForwardChainer::mk_source_rule(const std::string& msgprfx)
 		return mk_source_rule(msgprfx);
 	}
 
-	// Thompson sample according to rule tvs
+	// Select according to rule tvs, Thompson sampling by default
 	TruthValueSeq tvs = valid_rules.get_tvs();
-	RulePtr slc_rule = valid_rules[ThompsonSampling(tvs)()];
+	PolicySelection psel(tvs, _config.get_selection_policy(),
+	                     _config.get_tournament_size());
+	RulePtr slc_rule = valid_rules[psel()];
 	bool success = source->insert_rule(slc_rule);
 	if (not success)
 		return SourceRule();
@@ -472,9 +578,19 @@ SourceRule ForwardChainer::mk_source_rule(const std::string& msgprfx)
 
 void ForwardChainer::populate_source_rule_set(const std::string& msgprfx)
 {
+	PhaseTimers::Scope scope(_phase_timers, "populate_source_rule_set");
+
 	LAZY_URE_LOG_DEBUG << msgprfx << "Populate the source rule set (size="
 	                   << _source_rule_set.size() << ")";
-	int eps = _config.get_expansion_pool_size();
+	int eps = _config.get_expansion_pool_size(),
+		meps = _config.get_max_expansion_pool_size();
+	_source_rule_set.set_capacity(meps);
+	// Unless unlimited, the pool is not populated beyond its
+	// capacity. If unlimited, all pairs are produced but only the
+	// highest ranked ones are kept in the pool, the others in its
+	// overflow.
+	if (0 < eps and 0 < meps)
+		eps = std::min(eps, meps);
 	while (eps <= 0 or (int)_source_rule_set.size() < eps) {
 		// Build (source, rule) pair for application trial
 		SourceRule sr = mk_source_rule(msgprfx);
@@ -492,7 +608,8 @@ void ForwardChainer::populate_source_rule_set(const std::string& msgprfx)
 			LAZY_URE_LOG_DEBUG << msgprfx
 			                   << "Source rule pair:" << std::endl
 			                   << oc_to_string(sr) << std::endl
-			                   << "already in the source rule set";
+			                   << "already in the source rule set, "
+			                   << "or ranked too low to enter it";
 		}
 	}
 
@@ -504,7 +621,8 @@ void ForwardChainer::populate_source_rule_set(const std::string& msgprfx)
 std::pair<SourceRule, TruthValuePtr>
 ForwardChainer::select_source_rule(const std::string& msgprfx)
 {
-	return _source_rule_set.thompson_select();
+	return _source_rule_set.select(_config.get_selection_policy(),
+	                               _config.get_tournament_size());
 }
 
 TruthValuePtr ForwardChainer::calculate_source_rule_tv(const SourceRule& sr)
@@ -520,6 +638,8 @@ TruthValuePtr ForwardChainer::calculate_source_rule_tv(const SourceRule& sr)
 
 RuleSet ForwardChainer::get_valid_rules(const Source& source)
 {
+	PhaseTimers::Scope scope(_phase_timers, "get_valid_rules");
+
 	std::lock_guard<std::mutex> lock(_rules_mutex); // TODO: refine
 
 	// Generate all valid rules
@@ -532,8 +652,12 @@ RuleSet ForwardChainer::get_valid_rules(const Source& source)
 
 		const AtomSpace& ref_as(_search_focus_set ? *_focus_set_as.get() : _kb_as);
 		RuleTypedSubstitutionMap urm =
-			rule->unify_source(source.body, source.vardecl, &ref_as);
+			rule->unify_source(source.body, source.vardecl, &ref_as,
+			                   &_unify_cache);
 		RuleSet unified_rules = Rule::strip_typed_substitution(urm);
+		_stats.add(ChainerStats::UNIFICATIONS_ATTEMPTED);
+		if (not urm.empty())
+			_stats.add(ChainerStats::UNIFICATIONS_SUCCEEDED);
 
 		// Only insert unexhausted rules for this source
 		RuleSet une_rules;
@@ -595,27 +719,38 @@ RuleProbabilityPair ForwardChainer::select_rule(const RuleSet& valid_rules,
 	// Build vector of all valid truth values
 	TruthValueSeq tvs = valid_rules.get_tvs();
 
-	// Build action selection distribution
-	std::vector<double> weights = ThompsonSampling(tvs).distribution();
-
-	// Log the distribution
-	if (ure_logger().is_debug_enabled()) {
-		std::stringstream ss;
-		ss << msgprfx << "Rule weights:";
-		size_t i = 0;
-		for (const RulePtr& rule : valid_rules) {
-			ss << std::endl << weights[i] << " " << rule->get_name();
-			i++;
+	RulePtr selected_rule;
+	SelectionPolicy policy = _config.get_selection_policy();
+	if (policy == SelectionPolicy::Thompson) {
+		// Build action selection distribution
+		std::vector<double> weights = ThompsonSampling(tvs).distribution();
+
+		// Log the distribution
+		if (ure_logger().is_debug_enabled()) {
+			std::stringstream ss;
+			ss << msgprfx << "Rule weights:";
+			size_t i = 0;
+			for (const RulePtr& rule : valid_rules) {
+				ss << std::endl << weights[i] << " " << rule->get_name();
+				i++;
+			}
+			ure_logger().debug() << ss.str();
 		}
-		ure_logger().debug() << ss.str();
-	}
 
-	// Sample rules according to the weights
-	std::discrete_distribution<size_t> dist(weights.begin(), weights.end());
-	RulePtr selected_rule = rand_element(valid_rules, dist);
+		// Sample rules according to the weights
+		std::discrete_distribution<size_t> dist(weights.begin(), weights.end());
+		selected_rule = rand_element(valid_rules, dist);
+	} else {
+		// Directly select the rule if a cheaper selection policy is
+		// used
+		PolicySelection psel(tvs, policy, _config.get_tournament_size());
+		selected_rule = valid_rules[psel()];
+	}
 
 	// Calculate the probability estimate of having this rule fulfill
-	// the objective (required to calculate its complexity)
+	// the objective (required to calculate its complexity). It is the
+	// mean of the rule TV whatever the selection policy, not the
+	// probability of having been selected.
 	double prob = BetaDistribution(selected_rule->get_tv()).mean();
 
 	return RuleProbabilityPair{selected_rule, prob};
@@ -626,8 +761,15 @@ HandleSet ForwardChainer::apply_rule(const Rule& rule)
 	HandleSet results;
 
 	// Take the results from applying the rule, add them in the given
-	// AtomSpace and insert them in results
+	// AtomSpace and insert them in results.
+	//
+	// The results are first collected and deduplicated, then only
+	// those that are not already in the AtomSpace (as the pattern
+	// matcher usually already created them there) are added to it,
+	// and the results are inserted in a single batch.
 	auto add_results = [&](AtomSpace& as, const HandleSeq& hs) {
+		HandleSeq products;
+		products.reserve(hs.size());
 		for (const Handle& h : hs)
 		{
 			Type t = h->get_type();
@@ -635,32 +777,36 @@ HandleSet ForwardChainer::apply_rule(const Rule& rule)
 			// kinda means that to infer List or Set themselves you
 			// need to Quote them.
 			if (t == LIST_LINK or t == SET_LINK) {
-				for (const Handle& hc : h->getOutgoingSet()) {
-					results.insert(as.add_atom(hc));
-				}
+				const HandleSeq& outgoing = h->getOutgoingSet();
+				products.insert(products.end(), outgoing.begin(), outgoing.end());
 			} else {
-				results.insert(as.add_atom(h));
+				products.push_back(h);
 			}
 		}
+		std::sort(products.begin(), products.end());
+		products.erase(std::unique(products.begin(), products.end()),
+		               products.end());
+		for (Handle& product : products)
+			if (product->getAtomSpace() != &as)
+				product = as.add_atom(product);
+		results.insert(products.begin(), products.end());
 	};
 
 	// Wrap in try/catch in case the pattern matcher can't handle it
 	try
 	{
 		AtomSpace& ref_as(_search_focus_set ? *_focus_set_as.get() : _kb_as);
-		AtomSpacePtr derived_rule_as(createAtomSpace(&ref_as));
-		Handle rhcpy = derived_rule_as->add_atom(rule.get_rule());
 
 		// Make Sure that all constant clauses appear in the AtomSpace
 		// as unification might have created constant clauses which aren't
-		HandleSeq clauses = rule.get_clauses();
-		const HandleSet& varset = rule.get_variables().varset;
-		for (Handle clause : clauses)
-			if (is_constant(varset, clause))
-				if (ref_as.get_atom(clause) == Handle::UNDEFINED)
-					return results;
-
-		Handle h = HandleCast(rhcpy->execute(&ref_as));
+		if (not rule.is_applicable(ref_as))
+			return results;
+
+		// The rule body has been analyzed by the pattern matcher upon
+		// construction (clauses, connectivity, etc), execute it as is
+		// over ref_as rather than copying it in a temporary child
+		// atomspace, which would redo that analysis at every call.
+		Handle h = rule.apply(ref_as);
 		add_results(ref_as, h->getOutgoingSet());
 	}
 	catch (...) {}
@@ -670,9 +816,147 @@ HandleSet ForwardChainer::apply_rule(const Rule& rule)
 
 HandleSet ForwardChainer::apply_rule(const SourceRule& sr)
 {
+	PhaseTimers::Scope scope(_phase_timers, "apply_rule");
+
+	if (not _config.get_full_rule_application())
+		return apply_rule(*sr.rule);
+
+	if (_config.get_rete_rule_application())
+		return apply_rule_rete(sr.rule);
+
+	if (_config.get_semi_naive_rule_application()) {
+		HandleSet products = apply_rule_semi_naive(*sr.rule);
+		record_derived(products);
+		trim_derived();
+		return products;
+	}
+
 	return apply_rule(*sr.rule);
 }
 
+HandleSet ForwardChainer::apply_rule_semi_naive(const Rule& rule)
+{
+	// Fetch the atoms derived, or whose TVs have been updated, since
+	// the last application of the rule, and set its last application
+	// to now
+	HandleSet delta;
+	bool first_application;
+	{
+		std::lock_guard<std::mutex> lock(_derived_mutex);
+		auto it = _rule_derived_positions.find(rule.get_rule());
+		first_application = it == _rule_derived_positions.end();
+		if (not first_application)
+			for (auto dit = std::next(_derived.begin(),
+			                          it->second - _derived_offset);
+			     dit != _derived.end(); ++dit)
+				if (*dit)
+					delta.insert(*dit);
+		_rule_derived_positions[rule.get_rule()] =
+			_derived_offset + _derived.size();
+	}
+
+	// The first application is over the entire atomspace
+	if (first_application)
+		return apply_rule(rule);
+
+	LAZY_URE_LOG_DEBUG << "Semi-naive application of rule "
+	                   << rule.get_name() << " over " << delta.size()
+	                   << " newly derived atoms";
+
+	// Groundings only involving atoms present at the last
+	// application, with the same TVs, have already been produced, any
+	// other grounding has at least one premise grounded by a newly
+	// derived or updated atom. Thus it is enough to apply the
+	// specializations of the rule unified with each of them.
+	HandleSet results;
+	const AtomSpace& ref_as(_search_focus_set ? *_focus_set_as.get() : _kb_as);
+	for (const Handle& h : delta) {
+		RuleTypedSubstitutionMap urm =
+			rule.unify_source(h, Handle::UNDEFINED, &ref_as, &_unify_cache);
+		for (const RulePtr& ur : Rule::strip_typed_substitution(urm)) {
+			HandleSet ur_results = apply_rule(*ur);
+			results.insert(ur_results.begin(), ur_results.end());
+		}
+	}
+	return results;
+}
+
+HandleSet ForwardChainer::apply_rule_rete(const RulePtr& rule)
+{
+	const AtomSpace& ref_as(_search_focus_set ? *_focus_set_as.get() : _kb_as);
+	HandleSet results;
+	if (_rule_network.add_rule(rule, ref_as)) {
+		RuleSet matched_rules = _rule_network.pop_matches(*rule, ref_as);
+		LAZY_URE_LOG_DEBUG << "Rete application of rule " << rule->get_name()
+		                   << " over " << matched_rules.size() << " new matches";
+		for (const RulePtr& mr : matched_rules) {
+			HandleSet mr_results = apply_rule(*mr);
+			results.insert(mr_results.begin(), mr_results.end());
+		}
+	} else {
+		LAZY_URE_LOG_DEBUG << "Rule " << rule->get_name()
+		                   << " is not supported by the rule network, "
+		                   << "apply it over the entire atomspace";
+		results = apply_rule(*rule);
+	}
+
+	// Feed the products to the network, so that the next
+	// applications of the compiled rules take them into account
+	_rule_network.insert(results);
+	return results;
+}
+
+void ForwardChainer::record_derived(const HandleSet& products)
+{
+	std::lock_guard<std::mutex> lock(_derived_mutex);
+	for (const Handle& h : products)
+		record_derived(h);
+}
+
+void ForwardChainer::record_derived(const Handle& h)
+{
+	TruthValuePtr tv = h->getTruthValue();
+	size_t position = _derived_offset + _derived.size();
+	auto it = _derived_records.find(h);
+	if (it != _derived_records.end()) {
+		// Already recorded, record it again if its TV has changed so
+		// that the rules using it are re-applied, and clear its
+		// previous occurrence if still in the log, as any rule
+		// reaching it reaches the new one. Its sub-atoms have already
+		// been recorded.
+		if (*it->second.tv == *tv)
+			return;
+		if (_derived_offset <= it->second.position)
+			_derived[it->second.position - _derived_offset] = Handle::UNDEFINED;
+		it->second = {tv, position};
+		_derived.push_back(h);
+		return;
+	}
+
+	// Record it as well as its sub-atoms, as some may be new, and
+	// only match the premises of other rules by themselves.
+	_derived_records.emplace(h, DerivedRecord{tv, position});
+	_derived.push_back(h);
+	if (h->is_link())
+		for (const Handle& child : h->getOutgoingSet())
+			record_derived(child);
+}
+
+void ForwardChainer::trim_derived()
+{
+	std::lock_guard<std::mutex> lock(_derived_mutex);
+	if (_rule_derived_positions.empty())
+		return;
+
+	size_t min_position = _derived_offset + _derived.size();
+	for (const auto& rp : _rule_derived_positions)
+		min_position = std::min(min_position, rp.second);
+
+	_derived.erase(_derived.begin(),
+	               std::next(_derived.begin(), min_position - _derived_offset));
+	_derived_offset = min_position;
+}
+
 void ForwardChainer::validate(const Handle& source)
 {
 	if (source == Handle::UNDEFINED)
@@ -681,6 +965,8 @@ void ForwardChainer::validate(const Handle& source)
 
 void ForwardChainer::expand_meta_rules(const std::string& msgprfx)
 {
+	PhaseTimers::Scope scope(_phase_timers, "expand_meta_rules");
+
 	std::lock_guard<std::mutex> lock(_rules_mutex);
 	// This is kinda of hack before meta rules are fully supported by
 	// the Rule class.
@@ -24,12 +24,19 @@
 #ifndef _OPENCOG_FORWARDCHAINER_H_
 #define _OPENCOG_FORWARDCHAINER_H_
 
+#include <functional>
 #include <mutex>
+#include <unordered_map>
 // #include <shared_mutex>
 
+#include <opencog/unify/UnifyCache.h>
+
 #include "../UREConfig.h"
+#include "../PhaseTimers.h"
+#include "../ChainerStats.h"
 #include "SourceSet.h"
 #include "SourceRuleSet.h"
+#include "RuleNetwork.h"
 #include "FCStat.h"
 
 class ForwardChainerUTest;
@@ -48,6 +55,9 @@ class Rule;
 // objective
 typedef std::pair<RulePtr, double> RuleProbabilityPair;
 
+// Function called with each batch of products of the forward chainer
+typedef std::function<void(const HandleSet&)> ProductCallback;
+
 class ForwardChainer
 {
 public:
@@ -133,6 +143,51 @@ public:
 	Handle get_results() const;
 	HandleSet get_results_set() const;
 
+	/**
+	 * @return the number of iterations performed so far.
+	 */
+	int get_iteration() const;
+
+	/**
+	 * @return the time spent in each phase of the last call of
+	 * do_chain, if URE:phase-timing is enabled. The phases are
+	 * expand_meta_rules, select_source, get_valid_rules,
+	 * populate_source_rule_set, apply_rule and insert_sources.
+	 */
+	const PhaseTimers& get_phase_timers() const;
+
+	/**
+	 * @return the counts of unifications, rule applications and
+	 * sources of the last call of do_chain, see ChainerStats.
+	 */
+	const ChainerStats& get_stats() const;
+
+	/**
+	 * Register a callback called with the products of each rule
+	 * application, as soon as they are derived, so that they can be
+	 * consumed while forward chaining is running instead of waiting
+	 * for get_results. The products of an application may include
+	 * atoms already derived by previous ones. Calls are serialized,
+	 * even if multiple jobs are running.
+	 */
+	void set_product_callback(const ProductCallback& callback);
+
+	/**
+	 * Like above, but the callback executes the given grounded schema,
+	 * such as (GroundedSchemaNode "scm: consume") or
+	 * (GroundedSchemaNode "py: consume"), over a SetLink of the
+	 * products, i.e.
+	 *
+	 * ExecutionOutputLink
+	 *   <schema>
+	 *   ListLink
+	 *     SetLink
+	 *       <products>
+	 *
+	 * within the knowledge-base atomspace.
+	 */
+	void set_product_callback(const Handle& schema);
+
 private:
 	friend class ::ForwardChainerUTest;
 
@@ -142,8 +197,19 @@ private:
 
 	void apply_all_rules();
 
+	/**
+	 * Pass products to the product callback, if any.
+	 */
+	void stream_products(const HandleSet& products);
+
 	void validate(const Handle& source);
 
+	/**
+	 * Set the counters of sources tried and rules tried per source
+	 * from the current population of sources.
+	 */
+	void tally_sources();
+
 	/**
 	 * Expand all meta rules into mesa rules.
 	 *
@@ -208,10 +274,48 @@ private:
 
 	/**
 	 * Apply rule.
+	 *
+	 * When applying a source rule pair, if Rete or semi-naive rule
+	 * application is enabled (alongside full rule application), then
+	 * the rule is applied with apply_rule_rete or
+	 * apply_rule_semi_naive respectively.
 	 */
 	HandleSet apply_rule(const Rule& rule);
 	HandleSet apply_rule(const SourceRule& sr);
 
+	/**
+	 * Apply rule over the entire atomspace the first time, then only
+	 * over groundings involving at least one atom derived, or whose
+	 * TV has been updated by a rule, since its last application, that
+	 * is the specializations of the rule obtained by unifying its
+	 * premises with these atoms. Changes made to the atomspace by
+	 * other means than the rules are not taken into account.
+	 */
+	HandleSet apply_rule_semi_naive(const Rule& rule);
+
+	/**
+	 * Compile the rule into the rule network, then apply its
+	 * specializations by the matches produced since its last
+	 * application, and feed the products back to the network. If the
+	 * rule is not supported by the network, it is applied over the
+	 * entire atomspace.
+	 */
+	HandleSet apply_rule_rete(const RulePtr& rule);
+
+	/**
+	 * Record the derived atoms, and their sub-atoms, for semi-naive
+	 * rule application. Atoms already recorded are recorded again if
+	 * their TVs have changed.
+	 */
+	void record_derived(const HandleSet& products);
+	void record_derived(const Handle& h);
+
+	/**
+	 * Drop the prefix of _derived that every rule applied
+	 * semi-naively has already consumed.
+	 */
+	void trim_derived();
+
 	RuleSet _rules; /* loaded rules */
 
 	// Knowledge base atomspace
@@ -249,6 +353,12 @@ private:
 
 	FCStat _fcstat;
 
+	// Time spent in each phase
+	PhaseTimers _phase_timers;
+
+	// Counts of unifications, rule applications and sources
+	ChainerStats _stats;
+
 	// Enable alternative implementation using (source, rule) producer,
 	// srpi stands for Source Rule Producer Implementation. This flag
 	// is here, likely temporarily, to compare old and new way.
@@ -256,6 +366,41 @@ private:
 
 	// Set of weighted pairs (source, rule).
 	SourceRuleSet _source_rule_set;
+
+	// Cache of the unifications of the sources against the rules,
+	// sized by the unification-cache-size parameter.
+	UnifyCache _unify_cache;
+
+	// Function called with each batch of products, and mutex to
+	// serialize its calls.
+	ProductCallback _product_callback;
+	std::mutex _product_callback_mutex;
+
+	// Atoms derived so far, in order of derivation, for semi-naive
+	// rule application. Positions are absolute, _derived only holds
+	// the atoms from _derived_offset onward, the older ones having
+	// been consumed by all rules. An atom re-recorded after a TV
+	// change leaves an undefined handle at its previous position.
+	HandleSeq _derived;
+	size_t _derived_offset = 0;
+
+	// For each derived atom, its TV and position when last recorded.
+	struct DerivedRecord
+	{
+		TruthValuePtr tv;
+		size_t position;
+	};
+	std::unordered_map<Handle, DerivedRecord> _derived_records;
+
+	// For each rule body, the absolute size of _derived at its last
+	// application, so that the atoms derived since then are those
+	// from that position onward.
+	std::map<Handle, size_t> _rule_derived_positions;
+	mutable std::mutex _derived_mutex;
+
+	// Rete-style network of the rules applied so far, for Rete rule
+	// application.
+	RuleNetwork _rule_network;
 };
 
 } // ~namespace opencog
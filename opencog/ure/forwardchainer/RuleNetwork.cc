@@ -0,0 +1,435 @@
+/*
+ * RuleNetwork.cc
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * Author: agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "RuleNetwork.h"
+
+#include <algorithm>
+#include <set>
+
+#include <opencog/atoms/base/Link.h>
+#include <opencog/atoms/base/Node.h>
+#include <opencog/atoms/core/FindUtils.h>
+#include <opencog/unify/Unify.h>
+
+#include "../URELogger.h"
+
+namespace opencog {
+
+bool RuleNetwork::add_rule(const RulePtr& rule, const AtomSpace& as)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	Handle body = rule->get_rule();
+	if (_rules.find(body) != _rules.end())
+		return true;
+	if (_unsupported.find(body) != _unsupported.end())
+		return false;
+
+	HandleSeq premises = get_premises(*rule);
+	if (premises.empty()) {
+		_unsupported.insert(body);
+		return false;
+	}
+
+	CompiledRulePtr cr = std::make_shared<CompiledRule>();
+	cr->rule = rule;
+	cr->betas.resize(premises.size() - 1);
+	const HandleSet& varset = rule->get_variables().varset;
+	for (size_t i = 0; i < premises.size(); i++) {
+		HandleSeq variables;
+		Handle pattern = canonicalize(premises[i], varset, variables);
+		bool created;
+		AlphaMemory* am = get_alpha(pattern, variables.size(), created);
+
+		// Fill the new alpha memory with the atoms of as that match
+		// its pattern
+		if (created) {
+			Type t = pattern->get_type();
+			HandleSeq hs;
+			as.get_handles_by_type(hs, am->indices.count(pattern) ? ATOM : t,
+			                       true);
+			HandleSeq grounding;
+			for (const Handle& h : hs) {
+				if (feed(*am, h, grounding)) {
+					am->groundings.push_back(grounding);
+					_fed.emplace(h, h->getTruthValue());
+				}
+			}
+		}
+
+		am->successors.emplace_back(cr.get(), i);
+		cr->alphas.push_back(am);
+		cr->premise_variables.push_back(variables);
+	}
+
+	// Build the beta memories and pending matches of the rule from
+	// the groundings already in its alpha memories
+	std::vector<HandleMap> tokens;
+	for (const HandleSeq& grounding : cr->alphas[0]->groundings) {
+		HandleMap token;
+		if (join(*cr, 0, grounding, token))
+			tokens.push_back(std::move(token));
+	}
+	propagate(*cr, 0, std::move(tokens));
+
+	LAZY_URE_LOG_DEBUG << "Compiled rule " << rule->get_name()
+	                   << " into the rule network, with "
+	                   << cr->pending.size() << " pending matches";
+
+	_rules[body] = cr;
+	return true;
+}
+
+void RuleNetwork::insert(const Handle& h)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	insert_nolock(h);
+}
+
+void RuleNetwork::insert(const HandleSet& hs)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	for (const Handle& h : hs)
+		insert_nolock(h);
+}
+
+void RuleNetwork::insert_nolock(const Handle& h)
+{
+	TruthValuePtr tv = h->getTruthValue();
+	auto fit = _fed.find(h);
+	if (fit != _fed.end()) {
+		if (*fit->second == *tv)
+			return;
+		fit->second = tv;
+		update_nolock(h);
+		return;
+	}
+	_fed.emplace(h, tv);
+
+	auto insert_alpha = [&](AlphaMemory* am) {
+		HandleSeq grounding;
+		if (not feed(*am, h, grounding))
+			return;
+
+		// The grounding is propagated before being added to the
+		// memory, and in increasing order of premise index, so that
+		// a match involving h in several premises is produced once.
+		for (auto& successor : am->successors)
+			activate(*successor.first, successor.second, grounding);
+		am->groundings.push_back(grounding);
+	};
+
+	auto it = _typed_alphas.find(h->get_type());
+	if (it != _typed_alphas.end())
+		for (AlphaMemory* am : it->second)
+			insert_alpha(am);
+	for (AlphaMemory* am : _untyped_alphas)
+		insert_alpha(am);
+
+	// Sub-atoms may match premises as well
+	if (h->is_link())
+		for (const Handle& child : h->getOutgoingSet())
+			insert_nolock(child);
+}
+
+void RuleNetwork::update_nolock(const Handle& h)
+{
+	// Number of pending matches of each rule before the update
+	std::map<CompiledRule*, size_t> pending_sizes;
+	auto update_alpha = [&](AlphaMemory* am) {
+		if (am->atoms.find(h) == am->atoms.end())
+			return;
+		HandleSeq grounding(am->indices.size());
+		am->match(am->pattern, h, grounding);
+		for (auto& successor : am->successors) {
+			pending_sizes.emplace(successor.first,
+			                      successor.first->pending.size());
+			activate(*successor.first, successor.second, grounding, false);
+		}
+	};
+
+	auto it = _typed_alphas.find(h->get_type());
+	if (it != _typed_alphas.end())
+		for (AlphaMemory* am : it->second)
+			update_alpha(am);
+	for (AlphaMemory* am : _untyped_alphas)
+		update_alpha(am);
+
+	// A match involving h in several premises has been produced once
+	// per premise, only keep one.
+	for (const auto& ps : pending_sizes) {
+		std::vector<HandleMap>& pending = ps.first->pending;
+		std::set<HandleMap> produced;
+		auto last = std::remove_if(pending.begin() + ps.second, pending.end(),
+		                           [&](const HandleMap& token) {
+			                           return not produced.insert(token).second;
+		                           });
+		pending.erase(last, pending.end());
+	}
+}
+
+RuleSet RuleNetwork::pop_matches(const Rule& rule, const AtomSpace& as)
+{
+	std::vector<HandleMap> pending;
+	RulePtr base;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		auto it = _rules.find(rule.get_rule());
+		if (it == _rules.end())
+			return RuleSet();
+		std::swap(pending, it->second->pending);
+		base = it->second->rule;
+	}
+
+	RuleSet rules;
+	BindLinkPtr body = BindLinkCast(base->get_rule());
+	for (const HandleMap& token : pending) {
+		Rule sr(*base);
+		sr.set_rule(Unify::substitute(body, token, Handle::UNDEFINED, &as));
+		rules.insert(createRule(sr));
+	}
+	return rules;
+}
+
+size_t RuleNetwork::alpha_size() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _alphas.size();
+}
+
+size_t RuleNetwork::size() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _rules.size();
+}
+
+std::string RuleNetwork::to_string(const std::string& indent) const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	std::stringstream ss;
+	ss << indent << "alpha memories: size = " << _alphas.size() << std::endl;
+	int i = 0;
+	for (const auto& pa : _alphas) {
+		ss << indent << "alpha[" << i << "]: groundings = "
+		   << pa.second->groundings.size() << ", successors = "
+		   << pa.second->successors.size() << std::endl
+		   << oc_to_string(pa.first, indent + OC_TO_STRING_INDENT);
+		i++;
+	}
+	ss << indent << "rules: size = " << _rules.size() << std::endl;
+	i = 0;
+	for (const auto& pr : _rules) {
+		ss << indent << "rule[" << i << "]: " << pr.second->rule->get_name()
+		   << ", pending = " << pr.second->pending.size()
+		   << ", betas =";
+		for (const auto& beta : pr.second->betas)
+			ss << " " << beta.size();
+		ss << std::endl;
+		i++;
+	}
+	return ss.str();
+}
+
+HandleSeq RuleNetwork::get_premises(const Rule& rule)
+{
+	if (not rule.is_valid() or rule.is_meta())
+		return {};
+
+	HandleSeq premises;
+	for (const Handle& clause : rule.get_clauses()) {
+		// Ignore virtual clauses, they are evaluated by the pattern
+		// matcher when applying the specialized rule.
+		Type t = clause->get_type();
+		if (t == NOT_LINK or t == AND_LINK or t == OR_LINK or
+		    t == ABSENT_LINK or t == ALWAYS_LINK or
+		    nameserver().isA(t, VIRTUAL_LINK) or
+		    contains_atomtype(clause, GROUNDED_PREDICATE_NODE) or
+		    contains_atomtype(clause, GROUNDED_SCHEMA_NODE))
+			continue;
+		if (not is_supported(clause))
+			return {};
+		premises.push_back(clause);
+	}
+	return premises;
+}
+
+bool RuleNetwork::is_supported(const Handle& h)
+{
+	Type t = h->get_type();
+	if (t == QUOTE_LINK or t == UNQUOTE_LINK or t == LOCAL_QUOTE_LINK or
+	    t == GLOB_NODE or nameserver().isA(t, SCOPE_LINK) or
+	    nameserver().isA(t, UNORDERED_LINK))
+		return false;
+	if (h->is_link())
+		for (const Handle& child : h->getOutgoingSet())
+			if (not is_supported(child))
+				return false;
+	return true;
+}
+
+Handle RuleNetwork::canonicalize(const Handle& premise, const HandleSet& varset,
+                                 HandleSeq& variables)
+{
+	if (varset.find(premise) != varset.end()) {
+		auto it = std::find(variables.begin(), variables.end(), premise);
+		size_t i = std::distance(variables.begin(), it);
+		if (it == variables.end())
+			variables.push_back(premise);
+		return createNode(VARIABLE_NODE, "$ure-rete-" + std::to_string(i));
+	}
+	if (premise->is_node())
+		return premise;
+
+	HandleSeq oset;
+	for (const Handle& child : premise->getOutgoingSet())
+		oset.push_back(canonicalize(child, varset, variables));
+	return createLink(std::move(oset), premise->get_type());
+}
+
+RuleNetwork::AlphaMemory* RuleNetwork::get_alpha(const Handle& pattern,
+                                                 size_t arity,
+                                                 bool& created)
+{
+	auto it = _alphas.find(pattern);
+	created = it == _alphas.end();
+	if (not created)
+		return it->second.get();
+
+	AlphaMemoryPtr am = std::make_shared<AlphaMemory>();
+	am->pattern = pattern;
+	for (size_t i = 0; i < arity; i++)
+		am->indices[createNode(VARIABLE_NODE, "$ure-rete-" + std::to_string(i))] = i;
+	_alphas[pattern] = am;
+	if (am->indices.find(pattern) != am->indices.end())
+		_untyped_alphas.push_back(am.get());
+	else
+		_typed_alphas[pattern->get_type()].push_back(am.get());
+	return am.get();
+}
+
+bool RuleNetwork::feed(AlphaMemory& am, const Handle& h, HandleSeq& grounding)
+{
+	grounding = HandleSeq(am.indices.size());
+	if (not am.match(am.pattern, h, grounding))
+		return false;
+	return am.atoms.insert(h).second;
+}
+
+bool RuleNetwork::AlphaMemory::match(const Handle& pat, const Handle& h,
+                                     HandleSeq& values) const
+{
+	auto it = indices.find(pat);
+	if (it != indices.end()) {
+		Handle& value = values[it->second];
+		if (value)
+			return value == h;
+		value = h;
+		return true;
+	}
+
+	if (pat->get_type() != h->get_type())
+		return false;
+	if (pat->is_node())
+		return content_eq(pat, h);
+
+	const HandleSeq& pat_oset = pat->getOutgoingSet();
+	const HandleSeq& h_oset = h->getOutgoingSet();
+	if (pat_oset.size() != h_oset.size())
+		return false;
+	for (size_t i = 0; i < pat_oset.size(); i++)
+		if (not match(pat_oset[i], h_oset[i], values))
+			return false;
+	return true;
+}
+
+bool RuleNetwork::join(const CompiledRule& cr, size_t i,
+                       const HandleSeq& grounding, HandleMap& token)
+{
+	const HandleSeq& variables = cr.premise_variables[i];
+	const Variables& rule_variables = cr.rule->get_variables();
+	for (size_t j = 0; j < variables.size(); j++) {
+		auto it = token.find(variables[j]);
+		if (it != token.end()) {
+			if (it->second != grounding[j])
+				return false;
+		} else {
+			if (not rule_variables.is_type(variables[j], grounding[j]))
+				return false;
+			token.emplace(variables[j], grounding[j]);
+		}
+	}
+	return true;
+}
+
+void RuleNetwork::activate(CompiledRule& cr, size_t i, const HandleSeq& grounding,
+                           bool store)
+{
+	std::vector<HandleMap> tokens;
+	if (i == 0) {
+		HandleMap token;
+		if (join(cr, 0, grounding, token))
+			tokens.push_back(std::move(token));
+	} else {
+		for (const HandleMap& prev_token : cr.betas[i - 1]) {
+			HandleMap token(prev_token);
+			if (join(cr, i, grounding, token))
+				tokens.push_back(std::move(token));
+		}
+	}
+	propagate(cr, i, std::move(tokens), store);
+}
+
+void RuleNetwork::propagate(CompiledRule& cr, size_t i,
+                            std::vector<HandleMap> tokens, bool store)
+{
+	for (size_t k = i; not tokens.empty(); k++) {
+		// Complete groundings
+		if (k + 1 == cr.alphas.size()) {
+			cr.pending.insert(cr.pending.end(), tokens.begin(), tokens.end());
+			return;
+		}
+
+		// Partial groundings, store and extend them with the next
+		// premise
+		if (store) {
+			std::vector<HandleMap>& beta = cr.betas[k];
+			beta.insert(beta.end(), tokens.begin(), tokens.end());
+		}
+		std::vector<HandleMap> next_tokens;
+		for (const HandleMap& prev_token : tokens) {
+			for (const HandleSeq& grounding : cr.alphas[k + 1]->groundings) {
+				HandleMap token(prev_token);
+				if (join(cr, k + 1, grounding, token))
+					next_tokens.push_back(std::move(token));
+			}
+		}
+		tokens = std::move(next_tokens);
+	}
+}
+
+std::string oc_to_string(const RuleNetwork& rn, const std::string& indent)
+{
+	return rn.to_string(indent);
+}
+
+} // ~namespace opencog
@@ -0,0 +1,219 @@
+/*
+ * RuleNetwork.h
+ *
+ * Copyright (C) 2026 OpenCog Foundation
+ *
+ * Author: agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License v3 as
+ * published by the Free Software Foundation and including the exceptions
+ * at http://opencog.org/wiki/Licenses
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program; if not, write to:
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _OPENCOG_RULENETWORK_H_
+#define _OPENCOG_RULENETWORK_H_
+
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+#include <opencog/util/empty_string.h>
+#include <opencog/atoms/base/Handle.h>
+#include <opencog/atomspace/AtomSpace.h>
+
+#include "../Rule.h"
+
+namespace opencog
+{
+
+/**
+ * Rete-style incremental matching network of rules.
+ *
+ * Each rule premise (non-virtual clause) is compiled into an alpha
+ * memory, holding the groundings of that premise by the atoms fed to
+ * the network. Alpha memories are shared across premises, of the same
+ * rule or not, that are alpha-equivalent. Each rule has its own beta
+ * memories, holding the partial groundings of its first premises,
+ * consistent with each other and with the variable types of the rule.
+ *
+ * When an atom is fed to the network, its sub-atoms are fed as well,
+ * and only the new groundings they participate in are produced, and
+ * stored as pending matches of their rule, until these are popped to
+ * be applied. When an atom already fed is fed again with a different
+ * TV, the groundings it participates in are produced again.
+ *
+ * The network only provides candidate groundings of the premises,
+ * the virtual clauses are still evaluated by the pattern matcher when
+ * applying the rule specialized by each match.
+ */
+class RuleNetwork
+{
+public:
+	/**
+	 * Compile the given rule into the network, if not already, and
+	 * feed the newly created alpha memories with the atoms of as.
+	 * All groundings of the rule over the atoms fed to the network so
+	 * far are then pending.
+	 *
+	 * Return false if the rule is not supported by the network, that
+	 * is if it is a meta rule, has no premise, or has premises with
+	 * quotations, scopes, globs or unordered links.
+	 */
+	bool add_rule(const RulePtr& rule, const AtomSpace& as);
+
+	/**
+	 * Feed atoms, and their sub-atoms, to the network, producing new
+	 * pending matches. Atoms already fed are ignored, unless their
+	 * TVs have changed since, in which case the matches they
+	 * participate in are pending again.
+	 */
+	void insert(const Handle& h);
+	void insert(const HandleSet& hs);
+
+	/**
+	 * Return the specializations of the given rule by its pending
+	 * matches, and clear them. Constant clauses present in as are
+	 * removed from the specializations.
+	 */
+	RuleSet pop_matches(const Rule& rule, const AtomSpace& as);
+
+	/**
+	 * Number of alpha memories and compiled rules.
+	 */
+	size_t alpha_size() const;
+	size_t size() const;
+
+	std::string to_string(const std::string& indent=empty_string) const;
+
+private:
+	struct CompiledRule;
+
+	// Set of groundings of a premise, up to an alpha conversion.
+	// The premise is stored with its variables canonically renamed,
+	// so that alpha-equivalent premises share the same memory.
+	struct AlphaMemory
+	{
+		Handle pattern;
+
+		// Variable of the pattern to its index in a grounding
+		std::map<Handle, size_t> indices;
+
+		// Atoms fed to the memory, and the groundings of the pattern
+		// they have produced, one value per variable.
+		HandleSet atoms;
+		std::vector<HandleSeq> groundings;
+
+		// Rules, and premise indices, fed by this memory, in order of
+		// premise index within each rule.
+		std::vector<std::pair<CompiledRule*, size_t>> successors;
+
+		// Match h against pattern, filling values.
+		bool match(const Handle& pat, const Handle& h, HandleSeq& values) const;
+	};
+	typedef std::shared_ptr<AlphaMemory> AlphaMemoryPtr;
+
+	struct CompiledRule
+	{
+		RulePtr rule;
+
+		// Alpha memory of each premise, and the variables of the rule
+		// corresponding to the ones of its pattern.
+		std::vector<AlphaMemory*> alphas;
+		std::vector<HandleSeq> premise_variables;
+
+		// Beta memories, betas[k] holds the partial groundings of
+		// premises 0 to k. Complete groundings go to pending instead.
+		std::vector<std::vector<HandleMap>> betas;
+		std::vector<HandleMap> pending;
+	};
+	typedef std::shared_ptr<CompiledRule> CompiledRulePtr;
+
+	// Alpha memories indexed by pattern, and by root type of their
+	// pattern, or variable root for patterns that are variables.
+	std::map<Handle, AlphaMemoryPtr, content_based_handle_less> _alphas;
+	std::map<Type, std::vector<AlphaMemory*>> _typed_alphas;
+	std::vector<AlphaMemory*> _untyped_alphas;
+
+	// Compiled rules indexed by rule body, and rule bodies that are
+	// not supported.
+	std::map<Handle, CompiledRulePtr, content_based_handle_less> _rules;
+	HandleSet _unsupported;
+
+	// Atoms fed to the network, with their TVs at that time
+	std::unordered_map<Handle, TruthValuePtr> _fed;
+
+	mutable std::mutex _mutex;
+
+	// Return the premises of the rule to compile, that is its non
+	// virtual clauses. If the rule is not supported return an empty
+	// sequence.
+	static HandleSeq get_premises(const Rule& rule);
+
+	// Return true iff a premise term is supported by the network
+	static bool is_supported(const Handle& h);
+
+	// Rename variables of premise, in order of appearance, so that
+	// alpha-equivalent premises have the same pattern. Fill the
+	// variables of the premise in that order.
+	static Handle canonicalize(const Handle& premise, const HandleSet& varset,
+	                           HandleSeq& variables);
+
+	// Get or create the alpha memory of a pattern, with its number
+	// of variables. Set created to true if it has been created.
+	AlphaMemory* get_alpha(const Handle& pattern, size_t arity,
+	                       bool& created);
+
+	// Match an atom against the pattern of an alpha memory, and
+	// record it as fed. Return true iff it matches and has not been
+	// fed before, in which case grounding is filled, but remains to
+	// be added to the memory.
+	static bool feed(AlphaMemory& am, const Handle& h, HandleSeq& grounding);
+
+	// Extend the partial grounding token by the grounding of the
+	// i-th premise. Return false if they are inconsistent.
+	static bool join(const CompiledRule& cr, size_t i,
+	                 const HandleSeq& grounding, HandleMap& token);
+
+	// Join the new grounding of the i-th premise with the beta memory
+	// of the previous premises, and propagate the resulting tokens.
+	// If store is false the tokens are not stored in the beta
+	// memories, as when producing again the matches of a grounding
+	// already there.
+	static void activate(CompiledRule& cr, size_t i, const HandleSeq& grounding,
+	                     bool store=true);
+
+	// Store the new tokens of the i-th premise, unless store is
+	// false, then extend them with the groundings of the next
+	// premises, down to the pending matches.
+	static void propagate(CompiledRule& cr, size_t i,
+	                      std::vector<HandleMap> tokens, bool store=true);
+
+	void insert_nolock(const Handle& h);
+
+	// Produce again the matches h participates in, h having already
+	// been fed to the network.
+	void update_nolock(const Handle& h);
+};
+
+// Debugging helpers see
+// http://wiki.opencog.org/w/Development_standards#Print_OpenCog_Objects
+// The reason indent is not an optional argument with default is
+// because gdb doesn't support that, see
+// http://stackoverflow.com/questions/16734783 for more explanation.
+std::string oc_to_string(const RuleNetwork& rn,
+                         const std::string& indent=empty_string);
+
+} // ~namespace opencog
+
+#endif /* _OPENCOG_RULENETWORK_H_ */
@@ -22,10 +22,10 @@
 
 #include "SourceRuleSet.h"
 
-#include <boost/range/algorithm/lower_bound.hpp>
-#include <boost/algorithm/cxx11/all_of.hpp>
-
 #include <opencog/util/oc_assert.h>
+#include <opencog/util/random.h>
+
+#include "../BetaDistribution.h"
 
 namespace opencog {
 
@@ -40,13 +40,13 @@ SourceRule::~SourceRule()
 
 bool SourceRule::operator==(const SourceRule& other) const
 {
-	return &source == &other.source and &rule == &other.rule;
+	return source == other.source and rule == other.rule;
 }
 
 bool SourceRule::operator<(const SourceRule& other) const
 {
-	return (&source < &other.source)
-		or (&source == &other.source and &rule < &other.rule);
+	return (source < other.source)
+		or (source == other.source and rule < other.rule);
 }
 
 bool SourceRule::is_valid() const
@@ -67,60 +67,198 @@ std::string SourceRule::to_string(const std::string& indent) const
 }
 
 SourceRuleSet::SourceRuleSet()
-	: _thompson_smp(tv_seq)
+	: _policy(SelectionPolicy::Thompson), _capacity(-1), _selections(0)
 {
 }
 
 bool SourceRuleSet::insert(const SourceRule& sr, TruthValuePtr tv)
 {
-	auto it = boost::lower_bound(source_rule_seq, sr);
-	if (it == source_rule_seq.end() or *it != sr) {
-		it = source_rule_seq.insert(it, sr);
-		size_t idx = std::distance(source_rule_seq.begin(), it);
-		tv_seq.insert(std::next(tv_seq.begin(), idx), tv);
-		return true;
-	}
 	// The pair is already in the source rule set
-	return false;
+	if (_positions.find(sr) != _positions.end()
+	    or _overflow_tvs.find(sr) != _overflow_tvs.end())
+		return false;
+
+	double sc = score(tv);
+
+	// The set is full and the pair ranks below all others
+	if (0 <= _capacity and (int)_entries.size() >= _capacity
+	    and (_capacity == 0 or sc <= _ranking.begin()->first)) {
+		_overflow.insert({sc, sr});
+		_overflow_tvs[sr] = tv;
+		return false;
+	}
+
+	add(sr, tv, sc);
+	enforce_capacity();
+	return true;
 }
 
 std::pair<SourceRule, TruthValuePtr> SourceRuleSet::thompson_select()
 {
-	if (tv_seq.empty())
+	return select(SelectionPolicy::Thompson);
+}
+
+std::pair<SourceRule, TruthValuePtr> SourceRuleSet::tournament_select(unsigned size)
+{
+	return select(SelectionPolicy::Tournament, size);
+}
+
+std::pair<SourceRule, TruthValuePtr> SourceRuleSet::select(
+	SelectionPolicy policy, unsigned tournament_size)
+{
+	if (_entries.empty())
 		return {SourceRule(), nullptr};
 
+	// Recalculate the scores if the policy has changed, or if they
+	// have been used for as many selections as there are pairs, in
+	// the case of the random policies.
+	bool random_policy = policy == SelectionPolicy::Thompson
+		or policy == SelectionPolicy::SingleDrawThompson;
+	if (policy != _policy or (random_policy and _entries.size() <= _selections)) {
+		_policy = policy;
+		rescore();
+	}
+	_selections++;
+
 	// Select the next source rule pair to apply
-	size_t rnd_idx = _thompson_smp();
-	SourceRule slc_sr = source_rule_seq[rnd_idx];
-	TruthValuePtr slc_tv = tv_seq[rnd_idx];
+	size_t slc_pos;
+	if (policy == SelectionPolicy::Tournament) {
+		// Scores are means, pick the highest among random contenders
+		slc_pos = randGen().randint(_entries.size());
+		for (unsigned i = 1; i < tournament_size; i++) {
+			size_t pos = randGen().randint(_entries.size());
+			if (_entries[slc_pos].score < _entries[pos].score)
+				slc_pos = pos;
+		}
+	} else {
+		slc_pos = _positions.at(_ranking.rbegin()->second);
+	}
+	SourceRule slc_sr = _entries[slc_pos].sr;
+	TruthValuePtr slc_tv = _entries[slc_pos].tv;
 
-	// Remove it from the container to not be selected again
-	source_rule_seq.erase(std::next(source_rule_seq.begin(), rnd_idx));
-	tv_seq.erase(std::next(tv_seq.begin(), rnd_idx));
+	// Remove it from the container to not be selected again, and
+	// let the best overflown pair take its place
+	remove(slc_pos);
+	readmit();
 
 	// Return the selected source rule pair
 	return {slc_sr, slc_tv};
 }
 
+void SourceRuleSet::set_capacity(int capacity)
+{
+	_capacity = capacity;
+	enforce_capacity();
+	readmit();
+}
+
+size_t SourceRuleSet::overflow_size() const
+{
+	return _overflow.size();
+}
+
 bool SourceRuleSet::empty() const
 {
-	return source_rule_seq.empty();
+	return _entries.empty();
 }
 
 size_t SourceRuleSet::size() const
 {
-	return source_rule_seq.size();
+	return _entries.size();
+}
+
+double SourceRuleSet::score(const TruthValuePtr& tv) const
+{
+	BetaDistribution bd(tv);
+	switch (_policy) {
+	case SelectionPolicy::Thompson:
+	case SelectionPolicy::SingleDrawThompson:
+		return bd(randGen());
+	case SelectionPolicy::BayesUCB:
+		return bd.quantile(0.95);
+	case SelectionPolicy::Tournament:
+		return bd.mean();
+	}
+	OC_ASSERT(false, "Unknown selection policy");
+	return 0.0;
+}
+
+void SourceRuleSet::rescore()
+{
+	_ranking.clear();
+	for (Entry& entry : _entries) {
+		entry.score = score(entry.tv);
+		_ranking.insert({entry.score, entry.sr});
+	}
+	_selections = 0;
+
+	// Overflown pairs keep their scores, to not redraw them all at
+	// each period, but may now beat the lowest ones.
+	readmit();
+}
+
+void SourceRuleSet::remove(size_t pos)
+{
+	const Entry& entry = _entries[pos];
+	_ranking.erase({entry.score, entry.sr});
+	_positions.erase(entry.sr);
+	if (pos + 1 != _entries.size()) {
+		_entries[pos] = std::move(_entries.back());
+		_positions[_entries[pos].sr] = pos;
+	}
+	_entries.pop_back();
+}
+
+void SourceRuleSet::add(const SourceRule& sr, const TruthValuePtr& tv,
+                        double sc)
+{
+	_positions[sr] = _entries.size();
+	_entries.push_back({sr, tv, sc});
+	_ranking.insert({sc, sr});
+}
+
+void SourceRuleSet::enforce_capacity()
+{
+	while (0 <= _capacity and _capacity < (int)_entries.size()) {
+		const Entry& lowest = _entries[_positions.at(_ranking.begin()->second)];
+		_overflow.insert({lowest.score, lowest.sr});
+		_overflow_tvs[lowest.sr] = lowest.tv;
+		remove(_positions.at(lowest.sr));
+	}
+}
+
+void SourceRuleSet::readmit()
+{
+	while (not _overflow.empty()) {
+		auto highest = std::prev(_overflow.end());
+		bool room = _capacity < 0 or (int)_entries.size() < _capacity;
+		if (not room and (_capacity == 0
+		                  or highest->first <= _ranking.begin()->first))
+			break;
+
+		SourceRule sr = highest->second;
+		double sc = highest->first;
+		auto tv_it = _overflow_tvs.find(sr);
+		TruthValuePtr tv = tv_it->second;
+		_overflow.erase(highest);
+		_overflow_tvs.erase(tv_it);
+		add(sr, tv, sc);
+		enforce_capacity();
+	}
 }
 
 std::string SourceRuleSet::to_string(const std::string& indent) const
 {
 	std::stringstream ss;
 	std::string indent2 = indent + oc_to_string_indent;
-	ss << indent << "size = " << source_rule_seq.size();
+	ss << indent << "size = " << _entries.size()
+	   << ", overflow size = " << _overflow.size();
 	size_t i = 0;
-	for (const SourceRule& sr : source_rule_seq) {
+	// Display from the highest to the lowest ranked pair
+	for (auto it = _ranking.rbegin(); it != _ranking.rend(); ++it) {
 		ss << std::endl << indent << "(source,rule)[" << i << "]:"
-		   << std::endl << sr.to_string(indent2);
+		   << std::endl << it->second.to_string(indent2)
+		   << std::endl << indent << "score[" << i << "]: " << it->first;
 		i++;
 	}
 	return ss.str();
@@ -24,9 +24,12 @@
 #ifndef _OPENCOG_SOURCERULESET_H_
 #define _OPENCOG_SOURCERULESET_H_
 
+#include <map>
+#include <set>
+
 #include <opencog/util/empty_string.h>
 
-#include "../ThompsonSampling.h"
+#include "../SelectionPolicy.h"
 
 #include "SourceSet.h"
 
@@ -78,6 +81,23 @@ public:
  * via Thompson sampling ideally, or less ideally but possibly more
  * efficiently tournament selection.
  *
+ * To keep insertion, selection and removal in O(log n) each pair is
+ * ranked by a score calculated once according to the selection
+ * policy. For Thompson sampling that score is a first order
+ * probability drawn from the pair's TV, which amounts to a Thompson
+ * draw shared across selections. All scores are periodically redrawn
+ * (after as many selections as there are pairs, so that the cost is
+ * amortized) to not keep exploiting stale draws. For Bayes-UCB the
+ * score is the upper quantile of the TV, and for tournament
+ * selection its mean.
+ *
+ * The container may be bounded, in which case the pairs with the
+ * lowest scores are moved to an overflow when the capacity is
+ * exceeded. They keep their score there, and are re-admitted once
+ * there is room, or once their score beats the lowest score of the
+ * container, so that they do not have to be produced (thus
+ * unified) again.
+ *
  * This container is also called the Expansion Pool.
  */
 class SourceRuleSet
@@ -88,10 +108,21 @@ public:
 	/**
 	 * Insert (source, rule) pair in the container, alongside it's
 	 * second order probability of success. Return false if insertion
-	 * fails, that is such pair already exists in the container.
+	 * fails, that is such pair already exists in the container (or
+	 * its overflow), or the container is full and the pair ranks
+	 * below all others, in which case it is moved to the overflow.
 	 */
 	bool insert(const SourceRule& sr, TruthValuePtr tv);
 
+	/**
+	 * Select a pair according to the given selection policy and
+	 * remove it from the set. Return the empty source rule pair, and
+	 * the nullptr truth value if the set is empty.
+	 */
+	std::pair<SourceRule, TruthValuePtr> select(
+		SelectionPolicy policy=SelectionPolicy::Thompson,
+		unsigned tournament_size=2);
+
 	/**
 	 * Select a pair according to Thompson sampling and remove it from
 	 * the set. Return the empty source rule pair, and the nullptr
@@ -99,8 +130,24 @@ public:
 	 */
 	std::pair<SourceRule, TruthValuePtr> thompson_select();
 
-	// TODO: implement tournament selection as well, as a cheaper
-	// alternative to Thompson sampling.
+	/**
+	 * Like thompson_select but uses tournament selection, a cheaper
+	 * alternative to Thompson sampling.
+	 */
+	std::pair<SourceRule, TruthValuePtr> tournament_select(unsigned size=2);
+
+	/**
+	 * Set the maximum number of pairs the container can hold,
+	 * moving the lowest ranked ones to the overflow if it already
+	 * holds more, or re-admitting overflown ones if it has room.
+	 * Negative means unlimited.
+	 */
+	void set_capacity(int capacity);
+
+	/**
+	 * Return the number of pairs in the overflow.
+	 */
+	size_t overflow_size() const;
 
 	/**
 	 * Return true iff the pool is empty
@@ -118,20 +165,75 @@ public:
 	 */
 	std::string to_string(const std::string& indent=empty_string) const;
 
-	// Ordered sequence of source rule pairs.
-	std::vector<SourceRule> source_rule_seq;
+private:
+	// A weighted source rule pair alongside its score
+	struct Entry
+	{
+		SourceRule sr;
+		TruthValuePtr tv;
+		double score;
+	};
 
-	// Ordered sequence of Truth Values, representing the second order
-	// weights of each source rule pair. In the same order as
-	// source_rule_seq.
-	//
-	// It's easier here to have a sequence of TVs as opposed to having
-	// having weighted pairs because Thompson sampling takes in a
-	// sequence of TVs.
-	TruthValueSeq tv_seq;
+	/**
+	 * Calculate the score of a TV according to _policy.
+	 */
+	double score(const TruthValuePtr& tv) const;
 
-private:
-	ThompsonSampling _thompson_smp;
+	/**
+	 * Recalculate all scores, for instance after changing policy.
+	 */
+	void rescore();
+
+	/**
+	 * Remove the entry at position pos of _entries, by moving the
+	 * last entry in its place.
+	 */
+	void remove(size_t pos);
+
+	/**
+	 * Add an entry to _entries, _positions and _ranking.
+	 */
+	void add(const SourceRule& sr, const TruthValuePtr& tv, double sc);
+
+	/**
+	 * Move the lowest ranked entries to the overflow till the
+	 * capacity is respected.
+	 */
+	void enforce_capacity();
+
+	/**
+	 * Move the highest ranked overflown pairs back to the container
+	 * as long as there is room, or as long as they rank above the
+	 * lowest ranked entry, which then takes their place in the
+	 * overflow.
+	 */
+	void readmit();
+
+	// Entries in no particular order, allowing random access
+	// (required by tournament selection).
+	std::vector<Entry> _entries;
+
+	// Map each pair to its position in _entries, for detecting
+	// duplicates.
+	std::map<SourceRule, size_t> _positions;
+
+	// Pairs ranked by score.
+	std::set<std::pair<double, SourceRule>> _ranking;
+
+	// Pairs moved out of the container because of its capacity,
+	// ranked by the score they had, alongside their TVs.
+	std::set<std::pair<double, SourceRule>> _overflow;
+	std::map<SourceRule, TruthValuePtr> _overflow_tvs;
+
+	// Policy used to calculate the scores
+	SelectionPolicy _policy;
+
+	// Maximum number of pairs, negative means unlimited
+	int _capacity;
+
+	// Number of selections since the scores have been last
+	// calculated, used to trigger their periodic resampling.
+	size_t _selections;
 };
 
 std::string oc_to_string(const SourceRule& sr,
@@ -24,6 +24,8 @@
 
 #include <boost/range/algorithm/binary_search.hpp>
 #include <boost/range/algorithm/lower_bound.hpp>
+#include <boost/range/algorithm/merge.hpp>
+#include <boost/range/algorithm/sort.hpp>
 
 #include <opencog/util/numeric.h>
 #include <opencog/atoms/core/VariableSet.h>
@@ -206,8 +208,8 @@ bool SourceSet::is_exhausted() const
 	return exhausted;
 }
 
-void SourceSet::insert(const HandleSet& products, const Source& src,
-                       double prob, const std::string& msgprfx)
+size_t SourceSet::insert(const HandleSet& products, const Source& src,
+                         double prob, const std::string& msgprfx)
 {
 	std::lock_guard<std::mutex> lock(_mutex);
 	const static Handle empty_variable_set = Handle(createVariableSet(HandleSeq()));
@@ -218,6 +220,7 @@ void SourceSet::insert(const HandleSet& products, const Source& src,
 
 	// Keep all new sources
 	Sources new_srcs;
+	new_srcs.reserve(products.size());
 	for (const Handle& product : products) {
 		SourcePtr new_src = createSource(product, empty_variable_set,
 		                                 new_cpx, new_cpx_fctr);
@@ -232,11 +235,16 @@ void SourceSet::insert(const HandleSet& products, const Source& src,
 		}
 	}
 
-	// Insert all new sources
-	for (SourcePtr new_src : new_srcs) {
-		// Insert it while preserving the order
-		auto it = boost::lower_bound(sources, new_src, source_ptr_less());
-		sources.insert(it, new_src);
+	// Insert all new sources at once, by merging them with the
+	// existing ones while preserving the order, rather than inserting
+	// them one by one, which is quadratic in the number of products.
+	if (not new_srcs.empty()) {
+		boost::sort(new_srcs, source_ptr_less());
+		Sources merged_srcs;
+		merged_srcs.reserve(sources.size() + new_srcs.size());
+		boost::merge(sources, new_srcs, std::back_inserter(merged_srcs),
+		             source_ptr_less());
+		sources.swap(merged_srcs);
 	}
 
 	// Log the new sources
@@ -250,6 +258,8 @@ void SourceSet::insert(const HandleSet& products, const Source& src,
 		LAZY_URE_LOG_DEBUG << msgprfx << "New sources:"
 		                    << std::endl << new_src_bodies;
 	}
+
+	return new_srcs.size();
 }
 
 size_t SourceSet::size() const
@@ -144,8 +144,9 @@ public:
 	// True iff all rules that could expand the source have been tried
 	bool exhausted;
 
-	// Rules so far attempted on that source. Primary owner.
-	RuleSet rules;
+	// Rules so far attempted on that source. Primary owner. Hash
+	// indexed as it is queried at every step.
+	HashedRuleSet rules;
 
 private:
 	// TODO: subdivide in smaller and shared mutexes
@@ -196,9 +197,10 @@ public:
 	/**
 	 * Insert produced sources from src into the population, by
 	 * applying rule with a given probability of success prob (useful
-	 * for calculating complexity).
+	 * for calculating complexity). Return the number of new sources,
+	 * products already in the population being ignored.
 	 */
-	void insert(const HandleSet& products, const Source& src,
+	size_t insert(const HandleSet& products, const Source& src,
 	            double prob, const std::string& msgprfx="");
 
 	size_t size() const;
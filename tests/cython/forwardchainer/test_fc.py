@@ -62,6 +62,58 @@ class FCTest(TestCase):
         self.assertAlmostEqual(1.0, resultTV.mean, places=5)
         self.assertAlmostEqual(1.0, resultTV.confidence, places=5)
 
+    def test_fc_product_callback(self):
+        self.init()
+        scheme_eval(self.atomspace, '(load-from-path "fc-deduction-config.scm")')
+        # Record each streamed product as member of (Concept "streamed")
+        scheme_eval(self.atomspace,
+                    '(define (fc-consume products)'
+                    '  (for-each (lambda (p) (Member p (Concept "streamed")))'
+                    '            (cog-outgoing-set products))'
+                    '  products)')
+
+        A = ConceptNode("A")
+        B = ConceptNode("B")
+        C = ConceptNode("C")
+
+        InheritanceLink(A, B).tv = TruthValue(0.8, 0.9)
+        InheritanceLink(B, C).tv = TruthValue(0.98, 0.94)
+
+        chainer = ForwardChainer(self.atomspace,
+                                 ConceptNode("fc-deduction-rule-base"),
+                                 InheritanceLink(A, B))
+        chainer.set_product_callback(GroundedSchemaNode("scm: fc-consume"))
+        chainer.do_chain()
+        results = chainer.get_results()
+
+        streamed = set(l.out[0] for l in ConceptNode("streamed").incoming)
+        self.assertTrue(InheritanceLink(A, C) in streamed)
+        self.assertEqual(set(results.out), streamed)
+
+    def test_fc_phase_times(self):
+        self.init()
+        scheme_eval(self.atomspace, '(load-from-path "fc-deduction-config.scm")')
+        scheme_eval(self.atomspace,
+                    '(ure-set-phase-timing (Concept "fc-deduction-rule-base") #t)')
+
+        A = ConceptNode("A")
+        B = ConceptNode("B")
+        C = ConceptNode("C")
+
+        InheritanceLink(A, B).tv = TruthValue(0.8, 0.9)
+        InheritanceLink(B, C).tv = TruthValue(0.98, 0.94)
+
+        chainer = ForwardChainer(self.atomspace,
+                                 ConceptNode("fc-deduction-rule-base"),
+                                 InheritanceLink(A, B))
+        chainer.do_chain()
+        times = chainer.get_phase_times()
+
+        self.assertTrue("apply_rule" in times)
+        seconds, count = times["apply_rule"]
+        self.assertTrue(0 <= seconds)
+        self.assertTrue(0 < count)
+
 
 if __name__ == '__main__':
     os.environ["PROJECT_SOURCE_DIR"] = "../../.."
@@ -0,0 +1,71 @@
+;;
+;; Configuration file for a rule base with a rule matching atoms that
+;; are only sub-atoms of the products of another rule. Used to compare
+;; the semi-naive and Rete rule applications with the naive one.
+;;
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+;; Load required modules and utils ;;
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+
+(use-modules (opencog))
+(use-modules (opencog ure))
+
+;; Useful to run the unit tests without having to install opencog
+(load-from-path "ure-utils.scm")
+
+;;;;;;;;;;;;;;;;;;;;
+;; Knowledge base ;;
+;;;;;;;;;;;;;;;;;;;;
+
+(define sub-atom-kb
+  (map (lambda (i)
+         (Inheritance
+           (Concept (format #f "A~a" i))
+           (Concept (format #f "B~a" i))))
+       (iota 10)))
+
+;;;;;;;;;;;
+;; Rules ;;
+;;;;;;;;;;;
+
+;; Inheritance X Y
+;; |-
+;; Evaluation (Predicate "related") (List X Y)
+(define relate-rule
+  (let* ((X (Variable "$X"))
+         (Y (Variable "$Y")))
+    (Bind
+      (VariableSet
+        (TypedVariable X (Type "ConceptNode"))
+        (TypedVariable Y (Type "ConceptNode")))
+      (Present (Inheritance X Y))
+      (Evaluation (Predicate "related") (List X Y)))))
+
+;; Inheritance X Y
+;; List X Y
+;; |-
+;; Similarity X Y
+;;
+;; The List is only produced as a sub-atom of the products of
+;; relate-rule.
+(define similarity-rule
+  (let* ((X (Variable "$X"))
+         (Y (Variable "$Y")))
+    (Bind
+      (VariableSet
+        (TypedVariable X (Type "ConceptNode"))
+        (TypedVariable Y (Type "ConceptNode")))
+      (Present (Inheritance X Y) (List X Y))
+      (Similarity X Y))))
+
+(define relate-rule-name (DefinedSchema "relate-rule"))
+(Define relate-rule-name relate-rule)
+
+(define similarity-rule-name (DefinedSchema "similarity-rule"))
+(Define similarity-rule-name similarity-rule)
+
+;; Define a new rule base (aka rule-based system)
+(define fc-sub-atom-rbs (ConceptNode "fc-sub-atom-rule-base"))
+
+(ure-add-rules fc-sub-atom-rbs (list relate-rule-name similarity-rule-name))